@@ -3,29 +3,49 @@
 //#define SFML_STATIC
 
 #include "r_holders.h"
+#include "asset-pack.h"
 #include "r_ids.h"
 #include "s_stack.h"
 #include "player.h"
 #include "debug.h"
+#include "profiler-overlay.h"
+#include "task-thread.h"
 
 #include <SFML/System/Time.hpp>
 #include <SFML/Graphics/RenderWindow.hpp>
 
+#include <cstddef>
+#include <string>
+
 class Application {
 public:
     Application();
 
+    bool record_input(const std::string& filename);
+    bool replay_input(const std::string& filename);
     void run();
 private:
     void process_input();
     void update(sf::Time delta_time);
     void render();
     void register_states();
+    void dump_trace(const std::string& filename);
 
     sf::RenderWindow m_window;
+    // declared before the holders, fonts read from its mapping
+    AssetPack m_asset_pack;
     TextureHolder m_textures;
     FontHolder m_fonts;
     Player m_player;
     StateStack m_state_stack;
     Debug m_debug;
+    ProfilerOverlay m_profiler_overlay;
+    /// Time of the last hitch dump, dumps are at most HITCH_COOLDOWN apart.
+    sf::Clock m_since_hitch_dump;
+    std::size_t m_hitch_dump_count;
+    /// State stack changes seen, and whether the last frame changed it.
+    std::size_t m_state_changes;
+    bool m_is_state_change;
+    /// Writes dumped traces, declared last to be joined first.
+    TaskThread m_trace_writer;
 };
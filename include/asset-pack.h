@@ -0,0 +1,75 @@
+/** @file asset-pack.h
+ * Read-only, memory-mapped archive of pre-decoded assets.
+ * Built from res/ by the asset-packer target (tools/asset-packer.cpp), holders
+ * fall back to the loose files when an asset is not in the pack.
+ */
+
+#pragma once
+
+#include <SFML/System/NonCopyable.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * On-disk layout: Header, then Header::entry_count Entry records sorted by
+ * name, then the data of every entry (aligned to Pack::ALIGNMENT).
+ * @note Native byte order, the pack is built on the machine that runs it.
+ */
+namespace Pack {
+    constexpr char MAGIC[4] = {'O', 'C', 'C', 'P'};
+    constexpr std::uint32_t VERSION = 1;
+    constexpr std::size_t NAME_SIZE = 112;
+    constexpr std::size_t ALIGNMENT = 16;
+
+    enum class Type : std::uint32_t {
+        Texture,    // RGBA8 pixels, width * height * 4 bytes
+        Font,       // font file as is (sf::Font::loadFromMemory)
+        Blob,
+    };
+
+    struct Header {
+        char magic[4];
+        std::uint32_t version;
+        std::uint32_t entry_count;
+        std::uint32_t reserved;
+    };
+
+    struct Entry {
+        // path relative to res/, e.g. "textures/world/pool.png"
+        char name[NAME_SIZE];
+        Type type;
+        std::uint32_t width;
+        std::uint32_t height;
+        std::uint32_t reserved;
+        std::uint64_t offset;
+        std::uint64_t size;
+    };
+}
+
+/**
+ * @class AssetPack
+ * Maps a pack file and looks up its entries by name. Entry data points into
+ * the mapping, nothing is copied, and the OS page cache shares it between
+ * processes that map the same pack.
+ * @warning Data returned by get_data() is valid until close().
+ */
+class AssetPack : private sf::NonCopyable {
+public:
+    AssetPack();
+    ~AssetPack();
+
+    bool open(const std::string& filename);
+    void close();
+    bool is_open() const;
+    const Pack::Entry* find(const std::string& name) const;
+    const std::uint8_t* get_data(const Pack::Entry& entry) const;
+private:
+    bool read_index();
+
+    const std::uint8_t* m_data;
+    std::size_t m_size;
+    const Pack::Entry* m_entries;
+    std::size_t m_entry_count;
+};
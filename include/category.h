@@ -19,5 +19,7 @@ namespace Category {
 
         Creature = Player | MapAsset,
         Projectile = PlayerProjectile | EnemyProjectile,
+        // categories registered in the collision broad phase
+        Collidable = Creature | Projectile | Pickup,
     };
 }
@@ -0,0 +1,51 @@
+/** @file collision-grid.h
+ * Uniform-grid (spatial hash) broad phase for scene graph collisions.
+ * @see SceneNode::register_colliders() World::handle_collisions()
+ */
+
+#pragma once
+
+#include "scene_node.h"
+
+#include <SFML/Graphics/Rect.hpp>
+
+#include <vector>
+
+/**
+ * @class CollisionGrid
+ * Buckets collidable scene nodes by their bounding rectangle into fixed-size
+ * cells, so that only nodes sharing a cell are tested against each other.
+ * @note The grid is cleared and refilled every tick. Cell vectors keep their
+ * capacity across clear(), so steady-state ticks do not allocate.
+ */
+class CollisionGrid {
+public:
+    /**
+     * @struct Collider
+     * A registered scene node and its bounding rectangle, captured at insert
+     * time so each rect is only computed once per tick.
+     */
+    struct Collider {
+        SceneNode* node;
+        sf::FloatRect rect;
+    };
+
+    CollisionGrid(const sf::FloatRect& bounds, float cell_size);
+
+    void clear();
+    void insert(SceneNode& node);
+    void find_pairs(std::vector<SceneNode::Pair>& collision_pairs) const;
+    const std::vector<Collider>& get_colliders() const;
+private:
+    int cell_x(float x) const;
+    int cell_y(float y) const;
+
+    sf::FloatRect m_bounds;
+    float m_cell_size;
+    int m_columns;
+    int m_rows;
+    /// All registered colliders, cells store indices into this vector.
+    std::vector<Collider> m_colliders;
+    /// Row-major cells, m_cells[y * m_columns + x].
+    std::vector<std::vector<std::size_t>> m_cells;
+};
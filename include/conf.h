@@ -7,6 +7,7 @@
 #include <SFML/Window/ContextSettings.hpp>
 #include <SFML/Window/VideoMode.hpp>
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -18,6 +19,14 @@ namespace conf {
     static unsigned int RESOLUTION_Y = 768;
     static sf::Time TIME_PER_FRAME = sf::seconds(1.f / 60.f); // 60 fps
     static bool VSYNC_TRUE = true;
+    // built by the asset-packer target next to the executable
+    static std::string ASSET_PACK = "assets.pack";
+    // a frame this long dumps the trace (trace-hitch-<n>.json), at most
+    // once per cooldown; F4 dumps it any time (trace-<time>.json)
+    static sf::Time HITCH_TIME = sf::milliseconds(100);
+    static sf::Time HITCH_COOLDOWN = sf::seconds(30.f);
+    // hitch dumps rotate over trace-hitch-0.json to trace-hitch-<count - 1>
+    static std::size_t HITCH_DUMP_COUNT = 5;
 
     // info about OpenGL context
     static sf::ContextSettings CONTEXT_SETTINGS;
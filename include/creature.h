@@ -49,6 +49,7 @@ public:
     virtual unsigned int get_category() const;
     virtual sf::FloatRect get_bounding_rect() const;
     virtual bool is_marked_for_removal() const;
+    virtual bool is_static() const;
     bool is_allied() const;
     float get_max_speed() const;
     void attack();
@@ -0,0 +1,90 @@
+/** @file input-log.h
+ * Recording and replay of the actions of every game tick (Player::Action
+ * bits) of one game session, so a perf run can be repeated with exactly
+ * the same input. The log also keeps the random_int() seed: same build plus
+ * same log gives the same simulation.
+ */
+
+#pragma once
+
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * On-disk layout: Header, then Run records to the end of the file. A run is
+ * the same actions for some ticks in a row (held keys make long runs).
+ * @note Native byte order, like the asset pack.
+ */
+namespace InputLog {
+    constexpr char MAGIC[4] = {'O', 'C', 'C', 'I'};
+    constexpr std::uint32_t VERSION = 2;
+
+    struct Header {
+        char magic[4];
+        std::uint32_t version;
+        // tick the log was recorded at, replaying at another one diverges
+        std::uint32_t tick_microseconds;
+        // random_int() seed of the session, see seed_random()
+        std::uint32_t seed;
+    };
+
+    struct Run {
+        std::uint32_t ticks;
+        std::uint32_t actions;
+    };
+}
+
+/**
+ * @class InputRecorder
+ * Writes the actions of every tick as runs, buffered (no write per tick).
+ * The last run is written by close() or the destructor.
+ */
+class InputRecorder : private sf::NonCopyable {
+public:
+    InputRecorder();
+    ~InputRecorder();
+
+    bool open(const std::string& filename, sf::Time tick_time,
+              std::uint32_t seed);
+    void close();
+    bool is_open() const;
+    void record(std::uint32_t actions);
+    std::uint64_t get_tick_count() const;
+private:
+    void write_run();
+
+    std::ofstream m_file;
+    InputLog::Run m_run;
+    std::uint64_t m_tick_count;
+};
+
+/**
+ * @class InputReplay
+ * Gives back the actions of every tick of a log, read whole on open() so
+ * replaying doesn't touch the disk.
+ */
+class InputReplay : private sf::NonCopyable {
+public:
+    InputReplay();
+
+    bool open(const std::string& filename, sf::Time tick_time);
+    void close();
+    bool is_open() const;
+    bool next(std::uint32_t& actions);
+    bool is_finished() const;
+    std::uint64_t get_tick_count() const;
+    std::uint32_t get_seed() const;
+private:
+    std::vector<InputLog::Run> m_runs;
+    std::size_t m_run_index;
+    std::uint32_t m_run_tick;
+    std::uint64_t m_tick_count;
+    std::uint32_t m_seed;
+    bool m_is_open;
+};
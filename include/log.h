@@ -0,0 +1,108 @@
+/** @file log.h
+ * Leveled, asynchronous logging for hot paths (e.g., per tick). A log call
+ * copies a static format string and a few numbers into a lock-free queue,
+ * a writer thread formats and prints them. Levels under LOG_LEVEL are
+ * compiled out.
+ * @code
+ * Log::debug("Player position: ({}, {})", pos.x, pos.y);
+ * @endcode
+ * @remark Set the least level with -DLOG_LEVEL=<0 trace .. 4 error>, default
+ * is debug, info with NDEBUG.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <type_traits>
+
+#ifndef LOG_LEVEL
+    #ifdef NDEBUG
+        #define LOG_LEVEL 2
+    #else
+        #define LOG_LEVEL 1
+    #endif
+#endif
+
+namespace Log {
+    enum class Level {
+        Trace,
+        Debug,
+        Info,
+        Warn,
+        Error,
+    };
+
+    constexpr Level MIN_LEVEL = static_cast<Level>(LOG_LEVEL);
+    /// Most numbers per record, one per {} in the format.
+    constexpr std::size_t MAX_ARGS = 4;
+
+    /**
+     * @struct Record
+     * What a log call queues, formatted later by the writer thread.
+     */
+    struct Record {
+        std::chrono::steady_clock::time_point time;
+        /// Static string, {} for each argument.
+        const char* format;
+        double args[MAX_ARGS];
+        unsigned char arg_count;
+        Level level;
+    };
+
+    bool push(const Record& record);
+    void flush();
+    std::size_t get_dropped_count();
+
+    /**
+     * Queue a record if level is compiled in. Never blocks, the record is
+     * dropped if the writer fell far behind.
+     * @param const char (&format)[N]
+     * String literal (only the pointer is kept), {} for each argument.
+     * @param Args... args
+     * Numbers or enums.
+     */
+    template <Level level, std::size_t N, typename... Args>
+    void write(const char (&format)[N], Args... args)
+    {
+        static_assert(sizeof...(Args) <= MAX_ARGS, "Log: too many arguments");
+        static_assert(((std::is_arithmetic_v<Args> || std::is_enum_v<Args>)
+                    && ...), "Log: arguments must be numbers or enums");
+        if constexpr (level >= MIN_LEVEL) {
+            Record record{std::chrono::steady_clock::now(), format,
+                {static_cast<double>(args)...},
+                static_cast<unsigned char>(sizeof...(Args)), level};
+            push(record);
+        }
+    }
+
+    template <std::size_t N, typename... Args>
+    void trace(const char (&format)[N], Args... args)
+    {
+        write<Level::Trace>(format, args...);
+    }
+
+    template <std::size_t N, typename... Args>
+    void debug(const char (&format)[N], Args... args)
+    {
+        write<Level::Debug>(format, args...);
+    }
+
+    template <std::size_t N, typename... Args>
+    void info(const char (&format)[N], Args... args)
+    {
+        write<Level::Info>(format, args...);
+    }
+
+    template <std::size_t N, typename... Args>
+    void warn(const char (&format)[N], Args... args)
+    {
+        write<Level::Warn>(format, args...);
+    }
+
+    template <std::size_t N, typename... Args>
+    void error(const char (&format)[N], Args... args)
+    {
+        write<Level::Error>(format, args...);
+    }
+}
@@ -2,25 +2,44 @@
 
 //#define SFML_STATIC
 
+#include <SFML/System/NonCopyable.hpp>
 #include <SFML/System/Thread.hpp>
 #include <SFML/System/Mutex.hpp>
 #include <SFML/System/Lock.hpp>
-#include <SFML/System/Clock.hpp>
 
-class ParallelTask {
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <vector>
+
+/**
+ * @class ParallelTask
+ * Runs a list of tasks on worker threads, completion is the share of tasks
+ * done. Add every task before execute().
+ * @remark An exception thrown by a task is kept and rethrown by
+ * is_finished(), on the thread that polls it, and stops the tasks that have
+ * not started. Owners that never poll (e.g., TextureLoader) must catch in
+ * their tasks.
+ */
+class ParallelTask : private sf::NonCopyable {
 public:
-    // default &run task & &p_task
-    ParallelTask() : m_thread(&ParallelTask::run_task, this),
-        m_finished(false) {}
+    ParallelTask();
+    ~ParallelTask();
 
-    void execute();
+    void add_task(std::function<void ()> task);
+    void execute(unsigned int thread_count = 1);
+    void wait();
     bool is_finished();
     float get_completion();
 private:
     void run_task();
 
-    sf::Thread m_thread;
-    bool m_finished;
-    sf::Clock m_elapsed_time;
+    std::vector<std::function<void ()>> m_tasks;
+    std::vector<std::unique_ptr<sf::Thread>> m_threads;
+    std::size_t m_next_task;
+    std::size_t m_finished_tasks;
+    bool m_cancelled;
+    std::exception_ptr m_error;
     sf::Mutex m_mutex;
 };
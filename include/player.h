@@ -4,6 +4,7 @@
 
 #include "command.h"
 #include "task-thread.h"
+#include "input-log.h"
 
 #include "speech-to-text.h"
 
@@ -12,6 +13,7 @@
 
 #include <map>
 #include <memory>
+#include <string>
 
 extern sf::Vector2f PREV_PLAYER_MOVEMENT;
 
@@ -63,11 +65,17 @@ public:
     };
 
     // for one-time key presses
-    void handle_event(const sf::Event& event, CommandQueue& commands);
+    void handle_event(const sf::Event& event);
     // for real-time input
-    void handle_realtime_input(CommandQueue& commands);
+    void handle_realtime_input();
     // for local voice lib
-    void handle_stt_input(CommandQueue& commands);
+    void handle_stt_input();
+    // end of the tick, its actions become commands
+    void push_actions(CommandQueue& commands);
+    bool record_input(const std::string& filename);
+    bool replay_input(const std::string& filename);
+    void close_input_log();
+    bool is_replay_finished() const;
     // fn to bind keys and get assigned keys
     void assign_key(Action action, sf::Keyboard::Key key);
     sf::Keyboard::Key get_assigned_key(Action action) const;
@@ -76,7 +84,9 @@ public:
     /** @todo Returns nullptr until implemented. */
     char* print_assigned_key(Action action) const;
     void run_stt();
-    bool is_stt_running();
+    void stop_stt();
+    bool is_stt_running() const;
+    bool is_stt_ready() const;
 
 private:
     void initialize_actions();
@@ -124,5 +134,20 @@ private:
     */
     stt::Key _stt_key;
 
+    /**
+    * @var TaskThread _stt_task
+    * Runs _stt, declared after it so it is joined before _stt is destroyed.
+    */
     TaskThread _stt_task;
+
+    /**
+     * @var unsigned int m_actions
+     * Actions of the current tick (Action bits), pushed by push_actions().
+     */
+    unsigned int m_actions;
+
+    /// Open while recording, every tick's actions are written to it.
+    InputRecorder m_input_recorder;
+    /// Open while replaying, it gives the actions instead of the devices.
+    InputReplay m_input_replay;
 };
@@ -0,0 +1,39 @@
+#pragma once
+
+//#define SFML_STATIC
+
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/RectangleShape.hpp>
+#include <SFML/Graphics/Text.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+
+/**
+ * @class ProfilerOverlay
+ * Shows the Profiler summaries over the game: per phase its mean, 95th
+ * percentile and max in ms, and its histogram as bars. Toggled with F3 (see
+ * Application::process_input()).
+ * @remark Refreshed twice a second, not per frame, so it costs nothing
+ * measurable itself.
+ */
+class ProfilerOverlay : public sf::Drawable, private sf::NonCopyable {
+public:
+    ProfilerOverlay();
+
+    void set_font(const sf::Font& font);
+    void toggle();
+    bool is_visible() const;
+    void update(sf::Time delta_time);
+private:
+    void rebuild();
+    virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const;
+
+    sf::Text m_text;
+    sf::RectangleShape m_background;
+    /// Histogram bars, one quad per bucket per phase.
+    sf::VertexArray m_bars;
+    sf::Time m_since_rebuild;
+    bool m_is_visible;
+};
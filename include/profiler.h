@@ -0,0 +1,98 @@
+#pragma once
+
+//#define SFML_STATIC
+
+#include "trace.h"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+
+/**
+ * @class Profiler
+ * Frame-phase timings: how long each phase of the frame took over the last
+ * WINDOW frames, summarized as mean, 95th percentile, max and a histogram.
+ * Phases are timed with ProfileProbe.
+ * @note Main thread only (the game loop), no locking.
+ */
+class Profiler {
+public:
+    using Clock = Trace::Clock;
+
+    enum Phase {
+        Frame,
+        Input,
+        Update,
+        Commands,
+        Collisions,
+        Spawns,
+        SceneUpdate,
+        AdaptView,
+        Draw,
+        Display,
+        PhaseCount,
+    };
+
+    /// Frames a summary covers (4s at 60 fps).
+    static constexpr std::size_t WINDOW = 240;
+    /// Histogram buckets, see get_bucket_limit(), the last one is open.
+    static constexpr std::size_t BUCKET_COUNT = 9;
+
+    /**
+     * @struct Summary
+     * A phase over the window, in milliseconds.
+     */
+    struct Summary {
+        float mean;
+        float p95;
+        float max;
+        std::array<std::size_t, BUCKET_COUNT> buckets;
+        std::size_t count;
+    };
+
+    static void record(Phase phase, Clock::duration duration);
+    static Summary summarize(Phase phase);
+    static float get_last(Phase phase);
+    static const char* get_name(Phase phase);
+    static float get_bucket_limit(std::size_t bucket);
+    static void reset();
+private:
+    struct History {
+        std::array<float, WINDOW> samples;
+        std::size_t next;
+        std::size_t count;
+    };
+
+    static std::array<History, PhaseCount> m_histories;
+};
+
+/**
+ * @class ProfileProbe
+ * Times its scope as a phase, and traces it (see trace.h).
+ * @code
+ * {
+ *     ProfileProbe probe(Profiler::Collisions);
+ *     handle_collisions();
+ * }
+ * @endcode
+ */
+class ProfileProbe {
+public:
+    explicit ProfileProbe(Profiler::Phase phase) :
+        m_phase(phase),
+        m_start(Profiler::Clock::now())
+    {}
+
+    ~ProfileProbe()
+    {
+        Profiler::Clock::time_point end = Profiler::Clock::now();
+        Profiler::record(m_phase, end - m_start);
+        Trace::record(Profiler::get_name(m_phase), m_start, end);
+    }
+
+    ProfileProbe(const ProfileProbe&) = delete;
+    ProfileProbe& operator=(const ProfileProbe&) = delete;
+private:
+    Profiler::Phase m_phase;
+    Profiler::Clock::time_point m_start;
+};
@@ -4,6 +4,9 @@
 //#define NDEBUG
 
 #include "r_ids.h"
+#include "asset-pack.h"
+
+#include <SFML/Graphics/Image.hpp>
 
 #include <map>
 #include <string>
@@ -11,6 +14,15 @@
 #include <stdexcept>
 #include <cassert>
 
+/**
+ * @class TextureHolder
+ * Owns textures by Textures::ID.
+ * @note IDs loaded from the same file alias one sf::Texture (decoded and
+ * uploaded once), the texture is freed when the last ID is released.
+ * @warning Aliased IDs share state, e.g. setRepeated() applies to all of them.
+ * @remark With an AssetPack set, files in the pack are uploaded straight from
+ * its mapping (no file I/O or PNG decoding), other files are loaded as is.
+ */
 class TextureHolder {
 public:
     void load(Textures::ID id, const std::string& filename);
@@ -21,21 +33,36 @@ public:
     template <typename Optional>
     void load(Textures::ID id, const std::string& filename, const Optional& option);
 
+    // load from an already decoded image (e.g., decoded by TextureLoader)
+    void load(Textures::ID id, const std::string& filename,
+              const sf::Image& image);
+    bool load_cached(Textures::ID id, const std::string& filename);
+    bool load_packed(Textures::ID id, const std::string& filename);
+    void set_asset_pack(const AssetPack* asset_pack);
+    void release(Textures::ID id);
+    bool contains(Textures::ID id) const;
+
     sf::Texture& get(Textures::ID id);
     const sf::Texture& get(Textures::ID id) const;
 private:
-    void insert_texture(Textures::ID id, std::unique_ptr<sf::Texture> texture);
+    void insert_texture(Textures::ID id, std::shared_ptr<sf::Texture> texture);
+    static std::string canonical_path(const std::string& filename);
 
-    std::map<Textures::ID, std::unique_ptr<sf::Texture>> m_texture_map;
+    std::map<Textures::ID, std::shared_ptr<sf::Texture>> m_texture_map;
+    /// Canonical path to loaded texture, expires when the last ID is released.
+    std::map<std::string, std::weak_ptr<sf::Texture>> m_path_cache;
+    const AssetPack* m_asset_pack = nullptr;
 };
 
 // same implementation as texture holder - recreate as necessary
 class FontHolder {
 public:
     void load(Fonts::ID id, const std::string& filename);
+    void set_asset_pack(const AssetPack* asset_pack);
     sf::Font& get(Fonts::ID id);
     const sf::Font& get(Fonts::ID id) const;
 private:
     void insert_font(Fonts::ID id, std::unique_ptr<sf::Font> font);
     std::map<Fonts::ID, std::unique_ptr<sf::Font>> m_font_map;
+    const AssetPack* m_asset_pack = nullptr;
 };
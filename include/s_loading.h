@@ -3,7 +3,7 @@
 //#define SFML_STATIC
 
 #include <state.h>
-#include <p_task.h>
+#include <texture-loader.h>
 
 #include <SFML/Graphics/RectangleShape.hpp>
 #include <SFML/Graphics/Text.hpp>
@@ -22,5 +22,5 @@ private:
     sf::RectangleShape m_progress_bar_background;
     sf::RectangleShape m_progress_bar;
 
-    ParallelTask m_loading_task;
+    TextureLoader m_texture_loader;
 };
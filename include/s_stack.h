@@ -10,6 +10,7 @@
 #include <SFML/System/NonCopyable.hpp>
 #include <SFML/System/Time.hpp>
 
+#include <cstddef>
 #include <vector>
 #include <utility>
 #include <functional>
@@ -45,6 +46,7 @@ public:
     void clear_states();
 
     bool is_empty() const;
+    std::size_t get_change_count() const;
 private:
     struct PendingChange {
         explicit PendingChange(Action action,
@@ -60,6 +62,8 @@ private:
     // stack index to keeping track of states by ID
     std::vector<States::ID> m_stack_index;
     std::vector<PendingChange> m_pending_list;
+    /// Times pending changes were applied, see get_change_count().
+    std::size_t m_change_count;
     State::Context m_context;
     std::map<States::ID, std::function<State::Ptr()>> m_factories;
 };
@@ -11,7 +11,6 @@
 
 #include <vector>
 #include <memory>
-#include <set>
 #include <utility>
 
 /// Forward declaration of RenderTarget - only used locally in get_bounding_rect().
@@ -23,6 +22,10 @@ namespace sf {
 struct Command;
 /** @brief Forward declaration of CommandQueue to be used in implementation. */
 struct CommandQueue;
+/** @brief Forward declaration of CollisionGrid to be used in implementation. */
+class CollisionGrid;
+/** @brief Forward declaration of StaticColliders to be used in implementation. */
+class StaticColliders;
 
 class SceneNode :
     public sf::Transformable, // store its curr pos, rotatation,
@@ -49,19 +52,43 @@ public:
     // update scene
     void update(sf::Time delta_time, CommandQueue& commands);
     // absolute transformations
-    sf::Transform get_world_transform() const;
+    const sf::Transform& get_world_transform() const;
     sf::Vector2f get_world_position() const;
+    /**
+     * sf::Transformable mutators are not virtual, so they are hidden here to
+     * invalidate the cached world transform of the node and its children.
+     * @warning Move scene nodes through SceneNode (or derived) only, moving
+     * them through a sf::Transformable& skips the invalidation.
+     */
+    void setPosition(float x, float y);
+    void setPosition(const sf::Vector2f& position);
+    void setRotation(float angle);
+    void setScale(float factor_x, float factor_y);
+    void setScale(const sf::Vector2f& factors);
+    void setOrigin(float x, float y);
+    void setOrigin(const sf::Vector2f& origin);
+    void move(float offset_x, float offset_y);
+    void move(const sf::Vector2f& offset);
+    void rotate(float angle);
+    void scale(float factor_x, float factor_y);
+    void scale(const sf::Vector2f& factor);
     // virtual method that returns category of the game obj
     virtual unsigned int get_category() const;
     // non-virtual method, pass command to scene graph
     void on_command(const Command& command, sf::Time dt);
-    void check_node_collision(SceneNode& node, std::set<Pair>& collision_pairs);
-    void check_scene_collision(SceneNode& scene_graph,
-            std::set<Pair>& collision_pairs);
+    void register_colliders(CollisionGrid& grid);
+    void register_static_colliders(StaticColliders& colliders);
     virtual bool is_marked_for_removal() const;
     virtual bool is_destroyed() const;
+    virtual bool is_static() const;
     void removal();
     virtual sf::FloatRect get_bounding_rect() const;
+    const sf::FloatRect& get_subtree_bounds() const;
+    void draw_culled(sf::RenderTarget& target, const sf::FloatRect& view_bounds,
+                     sf::RenderStates states = sf::RenderStates::Default) const;
+protected:
+    // for derived classes whose bounding rect changes without moving
+    void invalidate_bounds();
 private:
     // to be overwritten by derived classes
     virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const;
@@ -74,10 +101,27 @@ private:
     void update_children(sf::Time dt, CommandQueue& commands);
     void draw_bounding_rect(sf::RenderTarget& target, sf::RenderStates states)
         const;
+    void invalidate_world_transform();
 
     std::vector<Ptr> m_children;
     SceneNode* m_parent;
     Category::Type m_default_category;
+    /**
+     * @var sf::Transform m_world_transform
+     * Cached absolute transform, valid while m_is_world_transform_dirty is
+     * false.
+     * @note If a node is dirty, all of its children are dirty too.
+     */
+    mutable sf::Transform m_world_transform;
+    mutable bool m_is_world_transform_dirty;
+    /**
+     * @var sf::FloatRect m_subtree_bounds
+     * Cached union of the bounding rects of the node and all its children,
+     * used to cull whole subtrees in draw_culled().
+     * @note If a node is dirty, all of its ancestors are dirty too.
+     */
+    mutable sf::FloatRect m_subtree_bounds;
+    mutable bool m_is_subtree_bounds_dirty;
 };
 
 bool collision(const SceneNode& lhs, const SceneNode& rhs);
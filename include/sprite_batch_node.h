@@ -0,0 +1,37 @@
+#pragma once
+
+#include "scene_node.h"
+
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Transform.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+
+#include <vector>
+
+// static sprites merged into one vertex array per texture, one draw call (and
+// texture bind) per texture instead of one per sprite node
+class SpriteBatchNode : public SceneNode {
+public:
+    SpriteBatchNode();
+
+    void add_sprite(const sf::Texture& texture, const sf::IntRect& texture_rect,
+                    const sf::Transform& transform);
+    void clear();
+    virtual sf::FloatRect get_bounding_rect() const;
+private:
+    /**
+     * @struct Batch
+     * Quads (as two triangles each) that sample the same texture.
+     */
+    struct Batch {
+        const sf::Texture* texture;
+        sf::VertexArray vertices;
+    };
+
+    virtual void draw_current(sf::RenderTarget& target, sf::RenderStates states)
+        const;
+
+    std::vector<Batch> m_batches;
+    // union of every quad, in local coordinates
+    sf::FloatRect m_local_bounds;
+};
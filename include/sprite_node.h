@@ -12,6 +12,7 @@ public:
     SpriteNode(const sf::Texture& texture, const sf::IntRect& texture_rect);
 
     void center_origin();
+    virtual sf::FloatRect get_bounding_rect() const;
 private:
     virtual void draw_current(sf::RenderTarget& target, sf::RenderStates states)
         const;
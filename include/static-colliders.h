@@ -0,0 +1,43 @@
+/** @file static-colliders.h
+ * Collider store for scene nodes that never move (MapAsset buildings).
+ * @see CollisionGrid for moving colliders.
+ */
+
+#pragma once
+
+#include "scene_node.h"
+
+#include <SFML/Graphics/Rect.hpp>
+
+#include <vector>
+
+/**
+ * @class StaticColliders
+ * Sorted interval structure over the bounding rectangles of static nodes.
+ * Rectangles are computed once when the store is built, and kept sorted by
+ * their left edge, so a query is a binary search plus a short scan.
+ * @warning Holds raw pointers, rebuild after removing static nodes from the
+ * scene graph.
+ */
+class StaticColliders {
+public:
+    void clear();
+    void insert(SceneNode& node);
+    void build();
+    void query(SceneNode& node, const sf::FloatRect& rect,
+               std::vector<SceneNode::Pair>& collision_pairs) const;
+    std::size_t size() const;
+private:
+    /**
+     * @struct Collider
+     * A static scene node and its (cached) bounding rectangle.
+     */
+    struct Collider {
+        SceneNode* node;
+        sf::FloatRect rect;
+    };
+
+    std::vector<Collider> m_colliders;
+    /// Widest collider, bounds how far left of a query a hit can start.
+    float m_max_width = 0.f;
+};
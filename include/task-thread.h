@@ -6,41 +6,39 @@
 
 #pragma once
 
-#include <mutex>
-#include <thread>
-#include <future>
-#include <condition_variable>
 #include <atomic>
+#include <exception>
 #include <functional>
+#include <mutex>
+#include <stop_token>
+#include <thread>
 
+/**
+ * @class TaskThread
+ * Runs one long task (e.g., SpeechToText::run()) on its own thread. The task
+ * gets a stop token and is expected to check it between units of work, stop()
+ * asks it to return and joins the thread.
+ * @remark The thread is always joined (by stop(), the next async(), or the
+ * destructor), never detached or cancelled: a task's resources are released
+ * by the time stop() returns.
+ */
 class TaskThread {
 public:
     TaskThread();
     ~TaskThread();
 
-    void async(std::function<void ()> task);
-    bool async_is_finished();
-    void join();
+    void async(std::function<void (std::stop_token)> task);
+    bool is_running() const;
+    bool is_finished();
+    void request_stop();
     void stop();
-    void wait();
-    void wakeup();
-    void native_cancel();
 private:
-    template <typename ReturnType>
-    void run_task(std::packaged_task<ReturnType ()>&& task);
+    void run_task(std::stop_token stop,
+                  std::function<void (std::stop_token)> task);
 
-    std::thread _th;
-    std::shared_future<bool> _fut;
+    std::jthread _th;
+    /// Set by async(), cleared by the thread when the task returns.
+    std::atomic<bool> _running;
+    std::exception_ptr _error;
     std::mutex _mtx;
-    std::condition_variable _cv;
-
-    // wake up the thread
-    std::atomic<bool> _wakeup;
-    bool _stop;
-    std::mutex _wakemtx;
-    std::condition_variable _wakecond;
-
-    // wait for the thread to finish its task
-    std::mutex _waitmtx;
-    std::condition_variable _waitcond;
 };
@@ -22,6 +22,7 @@ public:
     void set_outline_thickness(float thickness);
     void set_character_size(unsigned int size);
     void set_style(std::uint32_t style);
+    virtual sf::FloatRect get_bounding_rect() const;
 private:
     virtual void draw_current(sf::RenderTarget& target, sf::RenderStates states)
         const;
@@ -0,0 +1,76 @@
+/** @file texture-loader.h
+ * Decodes texture files in parallel, then uploads them into a TextureHolder.
+ */
+
+#pragma once
+
+#include "r_holders.h"
+#include "r_ids.h"
+#include "p_task.h"
+
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/Graphics/Image.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @class TextureLoader
+ * Image files are decoded into sf::Image by a ParallelTask, only the GPU
+ * upload (sf::Texture::loadFromImage) stays on the render thread.
+ * Loading then takes about as long as the largest file instead of the sum of
+ * all of them.
+ * @code
+ * TextureLoader loader(textures);
+ * loader.queue(Textures::Grass, "textures/world/new-grass.png");
+ * ...
+ * loader.launch();
+ * while (!loader.is_finished())
+ *     loader.upload(1);   // once per frame, get_completion() for progress
+ * @endcode
+ */
+class TextureLoader : private sf::NonCopyable {
+public:
+    explicit TextureLoader(TextureHolder& textures);
+    ~TextureLoader();
+
+    void queue(Textures::ID id, const std::string& filename);
+    void launch(unsigned int thread_count = 0);
+    std::size_t upload(std::size_t max_uploads
+            = std::numeric_limits<std::size_t>::max());
+    void wait();
+    bool is_finished() const;
+    float get_completion() const;
+private:
+    /**
+     * @struct Job
+     * One file, uploaded once and aliased for every ID that uses it.
+     */
+    struct Job {
+        std::string filename;
+        std::vector<Textures::ID> ids;
+        sf::Image image;
+        bool is_loaded = false;
+        // written by a worker, read by the render thread
+        std::atomic<bool> is_decoded = false;
+        bool is_uploaded = false;
+    };
+
+    void decode(Job& job);
+
+    TextureHolder& m_textures;
+    std::vector<std::unique_ptr<Job>> m_jobs;
+    std::atomic<std::size_t> m_decoded_count;
+    std::size_t m_uploaded_count;
+    // wakes up wait() when a job is decoded
+    std::mutex m_decoded_mutex;
+    std::condition_variable m_decoded_cond;
+    // one decoding task per job, declared last to be joined first
+    ParallelTask m_decoding;
+};
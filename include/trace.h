@@ -0,0 +1,85 @@
+/** @file trace.h
+ * Timeline of what each thread did, kept in a ring buffer (the last
+ * Trace::CAPACITY spans) and written as Chrome trace-event JSON, to open in
+ * chrome://tracing or ui.perfetto.dev.
+ * @code
+ * {
+ *     TraceScope scope("StateStack::apply_pending_changes");
+ *     ...
+ * }
+ * Trace::dump("trace.json");
+ * @endcode
+ * @remark snapshot() only copies the ring, write() can then run on another
+ * thread so the frame that asked for the trace isn't held up.
+ * @remark ProfileProbe phases are traced too. SpeechToText stages reach the
+ * trace through stt::set_trace_hook() (stt doesn't depend on the game).
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Trace {
+    using Clock = std::chrono::steady_clock;
+
+    /// Spans kept, older ones are overwritten.
+    constexpr std::size_t CAPACITY = 16384;
+
+    /**
+     * @struct Span
+     * A recorded span, times in microseconds since the program started.
+     */
+    struct Span {
+        const char* name;
+        std::int64_t begin;
+        std::int64_t duration;
+        std::uint32_t thread;
+    };
+
+    /**
+     * @struct Snapshot
+     * Copy of the ring and the thread names, see snapshot().
+     */
+    struct Snapshot {
+        std::vector<std::pair<std::uint32_t, std::string>> thread_names;
+        std::vector<Span> spans;
+    };
+
+    void record(const char* name, Clock::time_point begin,
+                Clock::time_point end);
+    void set_thread_name(const char* name);
+    void set_enabled(bool is_enabled);
+    Snapshot snapshot();
+    bool write(const Snapshot& snapshot, const std::string& filename);
+    bool dump(const std::string& filename);
+}
+
+/**
+ * @class TraceScope
+ * Records its scope as a span of the calling thread.
+ * @param const char* name
+ * Static string, only the pointer is kept.
+ */
+class TraceScope {
+public:
+    explicit TraceScope(const char* name) :
+        m_name(name),
+        m_begin(Trace::Clock::now())
+    {}
+
+    ~TraceScope()
+    {
+        Trace::record(m_name, m_begin, Trace::Clock::now());
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+private:
+    const char* m_name;
+    Trace::Clock::time_point m_begin;
+};
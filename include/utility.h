@@ -30,6 +30,7 @@ sf::Vector2f center_imbutton(const sf::Vector2f& gui_size,
 float to_degree(float radian);
 float to_radian(float degree);
 int random_int(int exclusive_max);
+void seed_random(unsigned long seed);
 float length(sf::Vector2f vec2);
 sf::Vector2f unit_vector(sf::Vector2f vec2);
 
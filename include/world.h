@@ -9,6 +9,9 @@
 #include "creature.h"
 #include "command_queue.h"
 #include "command.h"
+#include "collision-grid.h"
+#include "static-colliders.h"
+#include "texture-loader.h"
 
 #include <SFML/System/NonCopyable.hpp>
 #include <SFML/Graphics/View.hpp>
@@ -22,12 +25,12 @@
 
 /// Forward declarations to be used in implementation.
 namespace sf {
-	class RenderWindow;
+	class RenderTarget;
 }
 
 /**
  World must include...
-   * a ref to render window
+   * a ptr to the render target (null to simulate without drawing)
    * the world's current view
    * a texture holder with all the features needed inside the world
    * the scene graph
@@ -42,11 +45,15 @@ namespace sf {
 
 class World : private sf::NonCopyable { // non copyable, one world
 public:
-    explicit World(sf::RenderWindow& window, FontHolder& fonts);
+    explicit World(sf::RenderTarget* target, TextureHolder& textures,
+                   FontHolder& fonts);
 
     void update(sf::Time dt);
     void draw();
     CommandQueue& get_command_queue();
+    void add_creature(Creature::Type type, sf::Vector2f position);
+
+    static void queue_textures(TextureLoader& loader);
 private:
     /** @enum Layer
      * An enum for the world layers.
@@ -81,6 +88,7 @@ private:
     void add_map_asset(Creature::Type type, sf::Vector2f& coord);
     void add_map_assets();
     void spawn_map_assets();
+    void build_static_colliders();
     void destroy_entities_outside_chunk();
     // void guide_projectiles();
     sf::FloatRect get_view_bounds() const;
@@ -88,13 +96,14 @@ private:
     void handle_map_collisions();
     void handle_map_edges();
     void handle_player_death();
-    void load_map();
+    static void load_map(TextureLoader& loader);
     void build_map();
     void build_scenery();
 
-    sf::RenderWindow& m_window;
+    /// Null when headless (e.g., world-bench), draw() does nothing.
+    sf::RenderTarget* m_target;
     sf::View m_world_view;
-    TextureHolder m_textures;
+    TextureHolder& m_textures;
     /// FontHolder is reference and TextureHolder is not because of FontHolder&
     /// in default constructor.
     FontHolder& m_fonts;
@@ -111,6 +120,12 @@ private:
     /// Holds Ptr to all active NPCs.
     std::vector<Creature*> m_active_npcs;
     std::vector<SpawnPoint> _map_asset_spawn_points;
+    /// Broad phase for handle_collisions(), refilled every tick.
+    CollisionGrid m_collision_grid;
+    /// Buildings, indexed once after they are spawned.
+    StaticColliders m_static_colliders;
+    /// Reused every tick, so its capacity persists between ticks.
+    std::vector<SceneNode::Pair> m_collision_pairs;
 
     /**
     * @var sf::Image _map
@@ -10,6 +10,8 @@
 #include "utility.h"
 #include "conf.h"
 #include "debug.h"
+#include "profiler.h"
+#include "trace.h"
 
 #include <SFML/System.hpp>
 
@@ -18,6 +20,9 @@
 
 #include <stdexcept>
 #include <iostream>
+#include <memory>
+#include <ctime>
+#include <string>
 
 using namespace conf;
 
@@ -25,11 +30,20 @@ Application::Application() :
     // default resolution, title, & window style
     m_window(sf::VideoMode(RESOLUTION_X, RESOLUTION_Y, 16), TITLE,
             sf::Style::Close),
+    m_asset_pack(),
     m_textures(),
+    // starts loading the SpeechToText model on a worker thread, it's ready by
+    // the time the title screen is passed (states share it)
     m_player(),
     // reused context loading between states
     m_state_stack(State::Context(m_window, m_textures, m_fonts, m_player)),
-    m_debug()
+    m_debug(),
+    m_profiler_overlay(),
+    m_since_hitch_dump(),
+    m_hitch_dump_count(0),
+    m_state_changes(0),
+    m_is_state_change(false),
+    m_trace_writer()
 {
     // enable v-sync
     m_window.setVerticalSyncEnabled(VSYNC_TRUE);
@@ -50,8 +64,17 @@ Application::Application() :
     else
         std::cout << "ImGui initialized!" << std::endl;*/
 
+    // map pre-built asset pack (asset-packer target), loose files otherwise
+    if (m_asset_pack.open(ASSET_PACK)) {
+        m_textures.set_asset_pack(&m_asset_pack);
+        m_fonts.set_asset_pack(&m_asset_pack);
+    } else {
+        std::cout << "No asset pack, loading assets from files" << std::endl;
+    }
+
     // load main font
     m_fonts.load(Fonts::Main, "fonts/Kaph-Regular.ttf");
+    m_profiler_overlay.set_font(m_fonts.get(Fonts::Main));
     // load title screen
     m_textures.load(Textures::TitleScreen, "textures/title/main-menu-2.png");
 
@@ -59,6 +82,24 @@ Application::Application() :
     m_state_stack.push_state(States::Menu);
 }
 
+/**
+ * Record the game's input into filename, see Player::record_input().
+ * @return False if it can't be written.
+ */
+bool Application::record_input(const std::string& filename)
+{
+    return m_player.record_input(filename);
+}
+
+/**
+ * Replay filename as the game's input, the game closes when it ends.
+ * @return False if it isn't a usable log.
+ */
+bool Application::replay_input(const std::string& filename)
+{
+    return m_player.replay_input(filename);
+}
+
 void Application::run()
 {
     // debug if loop is entered
@@ -69,6 +110,8 @@ void Application::run()
 
     sf::Clock clock; // game clock
     sf::Time time_since_last_update = sf::Time::Zero;
+    // frame time, from one render() to the next
+    Profiler::Clock::time_point last_render = Profiler::Clock::now();
 
     // game poll, outer game loop -> variable rendering (as fast as possible)
     // game loop: (1) process_input, (2) update, (3) render
@@ -93,6 +136,32 @@ void Application::run()
             // NOTE: render needs to be guarded by if cond or else frames out of sync
             // render after main loop, everything is prepared and ready to render
             render();
+            Profiler::Clock::time_point now = Profiler::Clock::now();
+            Profiler::Clock::duration frame_time = now - last_render;
+            last_render = now;
+            Profiler::record(Profiler::Frame, frame_time);
+            // a state change (e.g., building the World) and the frame after
+            // it are slow on purpose, they are not hitches
+            std::size_t state_changes = m_state_stack.get_change_count();
+            bool is_state_change = state_changes != m_state_changes;
+            bool is_after_state_change = m_is_state_change;
+            m_state_changes = state_changes;
+            m_is_state_change = is_state_change;
+            // keep the lead-up of an unattended spike, rotating over
+            // HITCH_DUMP_COUNT files
+            if (frame_time > std::chrono::microseconds(
+                        HITCH_TIME.asMicroseconds())
+                    && !is_state_change && !is_after_state_change
+                    && (m_hitch_dump_count == 0
+                        || m_since_hitch_dump.getElapsedTime()
+                            >= HITCH_COOLDOWN)) {
+                dump_trace("trace-hitch-" + std::to_string(
+                            m_hitch_dump_count % HITCH_DUMP_COUNT) + ".json");
+                m_since_hitch_dump.restart();
+                ++m_hitch_dump_count;
+            }
+            m_profiler_overlay.update(sf::microseconds(std::chrono::duration_cast
+                        <std::chrono::microseconds>(frame_time).count()));
         // sleep until framerate matches expected
         } else {
             sf::sleep(TIME_PER_FRAME - time_since_last_update);
@@ -105,8 +174,18 @@ void Application::run()
 
 void Application::process_input()
 {
+    ProfileProbe probe(Profiler::Input);
     sf::Event event;
     while (m_window.pollEvent(event)) {
+        // F3 toggles frame timings, in every state
+        if (event.type == sf::Event::KeyPressed
+                && event.key.code == sf::Keyboard::F3)
+            m_profiler_overlay.toggle();
+        // F4 dumps the trace of the last seconds
+        if (event.type == sf::Event::KeyPressed
+                && event.key.code == sf::Keyboard::F4)
+            dump_trace("trace-" + std::to_string(std::time(nullptr))
+                    + ".json");
         m_state_stack.handle_event(event);
         if (event.type == sf::Event::Closed)
             m_window.close();
@@ -114,23 +193,57 @@ void Application::process_input()
 }
 
 void Application::update(sf::Time delta_time) {
+    ProfileProbe probe(Profiler::Update);
     //ImGui::SFML::Update(m_window, delta_time);
     m_state_stack.update(delta_time);
+    // no state left (e.g., menu exit, replay over), the game is done
+    if (m_state_stack.is_empty())
+        m_window.close();
 }
 
 void Application::render()
 {
-    // clear window
-    m_window.clear();
-    // redraw window (based on state)
-    m_state_stack.draw();
+    {
+        ProfileProbe probe(Profiler::Draw);
+        // clear window
+        m_window.clear();
+        // redraw window (based on state)
+        m_state_stack.draw();
+        if (m_profiler_overlay.is_visible()) {
+            m_window.setView(m_window.getDefaultView());
+            m_window.draw(m_profiler_overlay);
+        }
+    }
     // default view and display buffered window
     //m_window.setView(m_window.getDefaultView());
     //ImGui::SFML::Render(m_window);
     //ImGui::SFML::Render(m_window);
+    ProfileProbe probe(Profiler::Display);
     m_window.display();
 }
 
+/**
+ * Write the trace ring (main, SpeechToText and loader threads) to filename in
+ * the working directory. The ring is copied here, the JSON is written on
+ * m_trace_writer so the frame isn't held up.
+ * @note Dropped if the last trace is still being written.
+ */
+void Application::dump_trace(const std::string& filename)
+{
+    if (m_trace_writer.is_running()) {
+        std::cerr << "Trace still being written, skipped " << filename
+            << std::endl;
+        return;
+    }
+    auto snapshot = std::make_shared<Trace::Snapshot>(Trace::snapshot());
+    m_trace_writer.async([snapshot, filename] (std::stop_token) {
+        if (Trace::write(*snapshot, filename))
+            std::cout << "Trace written to " << filename << std::endl;
+        else
+            std::cerr << "Failed to write trace " << filename << std::endl;
+    });
+}
+
 void Application::register_states()
 {
     m_state_stack.register_state<TitleState>(States::Title);
@@ -0,0 +1,142 @@
+#include "asset-pack.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+    int compare_name(const Pack::Entry& entry, const std::string& name)
+    {
+        return std::strncmp(entry.name, name.c_str(), Pack::NAME_SIZE);
+    }
+}
+
+AssetPack::AssetPack() :
+    m_data(nullptr),
+    m_size(0),
+    m_entries(nullptr),
+    m_entry_count(0)
+{}
+
+AssetPack::~AssetPack()
+{
+    close();
+}
+
+/**
+ * Map a pack file.
+ * @return False if the file is missing or not a valid pack, the pack is then
+ * closed and every lookup misses.
+ */
+bool AssetPack::open(const std::string& filename)
+{
+    close();
+
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd == -1)
+        return false;
+
+    struct stat status;
+    if (fstat(fd, &status) == -1 || status.st_size <= 0) {
+        ::close(fd);
+        return false;
+    }
+
+    std::size_t size = static_cast<std::size_t>(status.st_size);
+    void* data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    // the mapping keeps the file alive
+    ::close(fd);
+    if (data == MAP_FAILED)
+        return false;
+
+    m_data = static_cast<const std::uint8_t*>(data);
+    m_size = size;
+    if (!read_index()) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void AssetPack::close()
+{
+    if (m_data)
+        munmap(const_cast<std::uint8_t*>(m_data), m_size);
+    m_data = nullptr;
+    m_size = 0;
+    m_entries = nullptr;
+    m_entry_count = 0;
+}
+
+bool AssetPack::is_open() const
+{
+    return m_data != nullptr;
+}
+
+/**
+ * @param const std::string& name
+ * Path of the asset relative to res/, as passed to the holders' load().
+ * @return The entry, or nullptr if the pack has no such asset.
+ */
+const Pack::Entry* AssetPack::find(const std::string& name) const
+{
+    if (name.size() >= Pack::NAME_SIZE)
+        return nullptr;
+
+    const Pack::Entry* last = m_entries + m_entry_count;
+    const Pack::Entry* found = std::lower_bound(m_entries, last, name,
+            [] (const Pack::Entry& entry, const std::string& name) {
+        return compare_name(entry, name) < 0;
+    });
+    if (found == last || compare_name(*found, name) != 0)
+        return nullptr;
+    return found;
+}
+
+const std::uint8_t* AssetPack::get_data(const Pack::Entry& entry) const
+{
+    return m_data + entry.offset;
+}
+
+/**
+ * Check the header and that every entry lies inside the mapping (so lookups
+ * never have to), then point m_entries at the index.
+ */
+bool AssetPack::read_index()
+{
+    if (m_size < sizeof(Pack::Header))
+        return false;
+
+    Pack::Header header;
+    std::memcpy(&header, m_data, sizeof(header));
+    if (std::memcmp(header.magic, Pack::MAGIC, sizeof(Pack::MAGIC)) != 0
+            || header.version != Pack::VERSION)
+        return false;
+
+    std::size_t entries_end = sizeof(Pack::Header)
+        + std::size_t(header.entry_count) * sizeof(Pack::Entry);
+    if (entries_end > m_size)
+        return false;
+
+    const Pack::Entry* entries = reinterpret_cast<const Pack::Entry*>(
+            m_data + sizeof(Pack::Header));
+    for (std::uint32_t i = 0; i < header.entry_count; ++i) {
+        const Pack::Entry& entry = entries[i];
+        if (entry.name[Pack::NAME_SIZE - 1] != '\0'
+                || entry.offset < entries_end
+                || entry.offset > m_size
+                || entry.size > m_size - entry.offset)
+            return false;
+        if (entry.type == Pack::Type::Texture
+                && entry.size != std::uint64_t(entry.width) * entry.height * 4)
+            return false;
+    }
+
+    m_entries = entries;
+    m_entry_count = header.entry_count;
+    return true;
+}
@@ -0,0 +1,112 @@
+#include "collision-grid.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+/**
+ * @param const sf::FloatRect& bounds
+ * Area covered by the grid (the world bounds). Colliders outside of it are
+ * clamped into the border cells, so they are still tested.
+ * @param float cell_size
+ * Width and height of one cell, in pixels. Should be around the size of the
+ * common collider, so most colliders only touch a few cells.
+ */
+CollisionGrid::CollisionGrid(const sf::FloatRect& bounds, float cell_size) :
+    m_bounds(bounds),
+    m_cell_size(cell_size),
+    m_columns(std::max(1, static_cast<int>(std::ceil(bounds.width / cell_size)))),
+    m_rows(std::max(1, static_cast<int>(std::ceil(bounds.height / cell_size)))),
+    m_colliders(),
+    m_cells(static_cast<std::size_t>(m_columns * m_rows))
+{
+    assert(cell_size > 0.f);
+}
+
+/**
+ * Empty every cell, keeping allocated capacity for the next tick.
+ */
+void CollisionGrid::clear()
+{
+    m_colliders.clear();
+    for (std::vector<std::size_t>& cell : m_cells)
+        cell.clear();
+}
+
+/**
+ * Register a node in every cell its bounding rectangle overlaps.
+ * @note Destroyed nodes and nodes without a bounding rectangle are ignored,
+ * they can never be part of a collision pair.
+ */
+void CollisionGrid::insert(SceneNode& node)
+{
+    if (node.is_destroyed())
+        return;
+
+    sf::FloatRect rect = node.get_bounding_rect();
+    if (rect.width <= 0.f || rect.height <= 0.f)
+        return;
+
+    std::size_t index = m_colliders.size();
+    m_colliders.push_back(Collider{&node, rect});
+
+    int left = cell_x(rect.left);
+    int right = cell_x(rect.left + rect.width);
+    int top = cell_y(rect.top);
+    int bottom = cell_y(rect.top + rect.height);
+    for (int y = top; y <= bottom; ++y)
+        for (int x = left; x <= right; ++x)
+            m_cells[y * m_columns + x].push_back(index);
+}
+
+/**
+ * Test colliders sharing a cell and append every intersecting pair.
+ * @param std::vector<SceneNode::Pair>& collision_pairs
+ * Output, pairs are ordered with std::minmax() like the old std::set was.
+ * @remark A pair that spans several cells is only reported by the cell that
+ * holds the top-left corner of the overlap, so the output has no duplicates
+ * without having to sort or hash it.
+ */
+void CollisionGrid::find_pairs(std::vector<SceneNode::Pair>& collision_pairs)
+    const
+{
+    for (int y = 0; y < m_rows; ++y) {
+        for (int x = 0; x < m_columns; ++x) {
+            const std::vector<std::size_t>& cell = m_cells[y * m_columns + x];
+            for (std::size_t i = 0; i < cell.size(); ++i) {
+                const Collider& lhs = m_colliders[cell[i]];
+                for (std::size_t j = i + 1; j < cell.size(); ++j) {
+                    const Collider& rhs = m_colliders[cell[j]];
+                    sf::FloatRect overlap;
+                    if (!lhs.rect.intersects(rhs.rect, overlap))
+                        continue;
+                    if (cell_x(overlap.left) != x || cell_y(overlap.top) != y)
+                        continue;
+                    collision_pairs.push_back(std::minmax(lhs.node, rhs.node));
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @return Every collider registered since the last clear().
+ */
+const std::vector<CollisionGrid::Collider>& CollisionGrid::get_colliders() const
+{
+    return m_colliders;
+}
+
+/// Column of x, clamped to the grid.
+int CollisionGrid::cell_x(float x) const
+{
+    int cell = static_cast<int>(std::floor((x - m_bounds.left) / m_cell_size));
+    return std::clamp(cell, 0, m_columns - 1);
+}
+
+/// Row of y, clamped to the grid.
+int CollisionGrid::cell_y(float y) const
+{
+    int cell = static_cast<int>(std::floor((y - m_bounds.top) / m_cell_size));
+    return std::clamp(cell, 0, m_rows - 1);
+}
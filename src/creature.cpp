@@ -6,6 +6,7 @@
 #include "utility.h"
 #include "pickup.h"
 #include "r_holders.h"
+#include "log.h"
 
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/RenderStates.hpp>
@@ -82,7 +83,7 @@ Creature::Creature(Type type, const TextureHolder& textures,
     //}
 
     // print success to match expected text updates with expected creatures
-    std::cout << "Text for creature updated\n";
+    Log::debug("Text for creature updated");
     update_texts();
 }
 
@@ -156,14 +157,13 @@ void Creature::update_pathing(sf::Time dt)
         /* NOTE: if the distance to travel is no multiple of the creature's
         speed, the creature will move further than intended. */
         float radians = to_radian(DIRECTIONS[m_direction_index].angle);
-        std::cout << "Radians of creature: " << radians << "\n";
+        Log::trace("Radians of creature: {}", radians);
         // velocity for x = speed * cos(radians)
         float vx = get_max_speed() * std::cos(radians);
         // velocity for y = speed * sin(radians)
         float vy = get_max_speed() * std::sin(radians);
         set_velocity(vx, vy);
-        std::cout << "Velocity of creature: " << vx << "x*" << vy << "y"
-            << std::endl;
+        Log::trace("Velocity of creature: {}x*{}y", vx, vy);
         // distance travelled = speed * time
         m_travelled_distance += get_max_speed() * dt.asSeconds();
     }
@@ -358,11 +358,7 @@ void Creature::update_texts()
         break;
     case Creature::Mbcc:
         m_health_display->set_string(
-<<<<<<< HEAD
                 "Mathematics Business & Computing Center");
-=======
-                "Mathematics Business & Computer Center");
->>>>>>> 70358e4573c4f036ca0905dffe86c5741d7fd904
         m_health_display->setPosition(0.f, 553.f);
         break;
     case Creature::Maintenance:
@@ -464,6 +460,15 @@ bool Creature::is_allied() const
     return m_type == Player;
 }
 
+/**
+ * Check if Creature never moves (MapAsset buildings have no speed).
+ * @return True if static, false if not.
+ */
+bool Creature::is_static() const
+{
+    return !is_allied() && get_max_speed() == 0.f;
+}
+
 /**
  * Get max speed of Creature.
  * @return Max speed of Creature::Type from data_tables.cpp.
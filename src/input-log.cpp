@@ -0,0 +1,179 @@
+#include "input-log.h"
+
+#include <cstring>
+#include <limits>
+
+namespace {
+    std::uint32_t to_tick_microseconds(sf::Time tick_time)
+    {
+        return static_cast<std::uint32_t>(tick_time.asMicroseconds());
+    }
+}
+
+InputRecorder::InputRecorder() :
+    m_file(),
+    m_run{0, 0},
+    m_tick_count(0)
+{}
+
+InputRecorder::~InputRecorder()
+{
+    close();
+}
+
+/**
+ * Start a log, a log already open is closed first.
+ * @return False if the file can't be written.
+ */
+bool InputRecorder::open(const std::string& filename, sf::Time tick_time,
+        std::uint32_t seed)
+{
+    close();
+    m_file.open(filename, std::ios::binary | std::ios::trunc);
+    if (!m_file)
+        return false;
+
+    InputLog::Header header{};
+    std::memcpy(header.magic, InputLog::MAGIC, sizeof(header.magic));
+    header.version = InputLog::VERSION;
+    header.tick_microseconds = to_tick_microseconds(tick_time);
+    header.seed = seed;
+    m_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    m_run = {0, 0};
+    m_tick_count = 0;
+    return static_cast<bool>(m_file);
+}
+
+/**
+ * Write the last run and close the log.
+ */
+void InputRecorder::close()
+{
+    if (!m_file.is_open())
+        return;
+    write_run();
+    m_file.close();
+}
+
+bool InputRecorder::is_open() const
+{
+    return m_file.is_open();
+}
+
+/**
+ * Record the actions of one tick (Player::Action bits), call once per tick
+ * even if there are none.
+ */
+void InputRecorder::record(std::uint32_t actions)
+{
+    if (!m_file.is_open())
+        return;
+    if (m_run.ticks > 0 && (m_run.actions != actions
+                || m_run.ticks == std::numeric_limits<std::uint32_t>::max()))
+        write_run();
+    m_run.actions = actions;
+    ++m_run.ticks;
+    ++m_tick_count;
+}
+
+std::uint64_t InputRecorder::get_tick_count() const
+{
+    return m_tick_count;
+}
+
+void InputRecorder::write_run()
+{
+    if (m_run.ticks == 0)
+        return;
+    m_file.write(reinterpret_cast<const char*>(&m_run), sizeof(m_run));
+    m_run = {0, 0};
+}
+
+InputReplay::InputReplay() :
+    m_runs(),
+    m_run_index(0),
+    m_run_tick(0),
+    m_tick_count(0),
+    m_seed(0),
+    m_is_open(false)
+{}
+
+/**
+ * Read a whole log, to replay from its first tick.
+ * @return False if the file is missing, not a log, or recorded at another
+ * tick than tick_time (the replay would diverge).
+ */
+bool InputReplay::open(const std::string& filename, sf::Time tick_time)
+{
+    close();
+    std::ifstream file(filename, std::ios::binary);
+    InputLog::Header header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))
+            || std::memcmp(header.magic, InputLog::MAGIC,
+                sizeof(header.magic)) != 0
+            || header.version != InputLog::VERSION
+            || header.tick_microseconds != to_tick_microseconds(tick_time))
+        return false;
+
+    InputLog::Run run;
+    while (file.read(reinterpret_cast<char*>(&run), sizeof(run)))
+        if (run.ticks > 0)
+            m_runs.push_back(run);
+    m_seed = header.seed;
+    m_is_open = true;
+    return true;
+}
+
+void InputReplay::close()
+{
+    m_runs.clear();
+    m_run_index = 0;
+    m_run_tick = 0;
+    m_tick_count = 0;
+    m_seed = 0;
+    m_is_open = false;
+}
+
+bool InputReplay::is_open() const
+{
+    return m_is_open;
+}
+
+/**
+ * Actions of the next tick.
+ * @return False once every tick of the log was replayed.
+ */
+bool InputReplay::next(std::uint32_t& actions)
+{
+    if (is_finished())
+        return false;
+    const InputLog::Run& run = m_runs[m_run_index];
+    actions = run.actions;
+    ++m_tick_count;
+    if (++m_run_tick == run.ticks) {
+        ++m_run_index;
+        m_run_tick = 0;
+    }
+    return true;
+}
+
+bool InputReplay::is_finished() const
+{
+    return m_run_index >= m_runs.size();
+}
+
+/**
+ * @return Ticks replayed so far.
+ */
+std::uint64_t InputReplay::get_tick_count() const
+{
+    return m_tick_count;
+}
+
+/**
+ * @return random_int() seed the log was recorded with.
+ */
+std::uint32_t InputReplay::get_seed() const
+{
+    return m_seed;
+}
@@ -0,0 +1,181 @@
+#include "log.h"
+#include "bounded-mpsc-queue.h"
+
+#include <atomic>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace {
+    // records queued at most (~4s of a record per tick at 60 Hz, times 16)
+    constexpr std::size_t QUEUE_CAPACITY = 4096;
+    // the writer sleeps this long when the queue is empty
+    constexpr std::chrono::milliseconds WRITER_INTERVAL(10);
+
+    const char LEVEL_NAMES[] = {'T', 'D', 'I', 'W', 'E'};
+    // records are stamped before the logger starts (the first one starts it)
+    const std::chrono::steady_clock::time_point START =
+        std::chrono::steady_clock::now();
+
+    /**
+     * @class Logger
+     * Bounded lock-free multi-producer/single-consumer queue of records (the
+     * stt::BoundedMpscQueue of stt::KeyQueue), and the writer thread that
+     * drains it.
+     */
+    class Logger {
+    public:
+        Logger();
+        ~Logger();
+
+        bool push(const Log::Record& record);
+        void flush();
+        std::size_t get_dropped_count() const;
+    private:
+        void run();
+        void print(const Log::Record& record);
+
+        stt::BoundedMpscQueue<Log::Record> _records;
+        std::atomic<std::size_t> _written;
+        std::atomic<std::size_t> _dropped;
+        std::string _line;
+        std::atomic<bool> _run;
+        std::thread _writer;
+    };
+
+    Logger::Logger() :
+        _records(QUEUE_CAPACITY),
+        _written(0),
+        _dropped(0),
+        _line(),
+        _run(true),
+        _writer()
+    {
+        _writer = std::thread(&Logger::run, this);
+    }
+
+    /**
+     * Everything queued is written before the writer stops.
+     */
+    Logger::~Logger()
+    {
+        _run = false;
+        _writer.join();
+    }
+
+    /**
+     * Producer side, any thread.
+     * @return False if the queue is full (the record is dropped).
+     */
+    bool Logger::push(const Log::Record& record)
+    {
+        if (_records.push(record))
+            return true;
+        _dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    /**
+     * Wait until the writer wrote what was queued before the call.
+     */
+    void Logger::flush()
+    {
+        std::size_t queued = _records.get_push_count();
+        while (_written.load(std::memory_order_acquire) < queued)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    std::size_t Logger::get_dropped_count() const
+    {
+        return _dropped.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Writer thread: drain, print, flush the streams once per batch.
+     */
+    void Logger::run()
+    {
+        Log::Record record;
+        for (;;) {
+            bool run = _run;
+            bool has_written = false;
+            while (_records.pop(record)) {
+                print(record);
+                has_written = true;
+                _written.fetch_add(1, std::memory_order_release);
+            }
+            if (has_written) {
+                std::cout.flush();
+                std::cerr.flush();
+            }
+            if (!run)
+                break;
+            std::this_thread::sleep_for(WRITER_INTERVAL);
+        }
+    }
+
+    /**
+     * Format a record (seconds since START, level, then format with each {}
+     * replaced by the next argument) and print it, warnings and errors to
+     * std::cerr.
+     */
+    void Logger::print(const Log::Record& record)
+    {
+        char number[32];
+        std::chrono::duration<double> since = record.time - START;
+        std::snprintf(number, sizeof(number), "[%.3f %c] ", since.count(),
+                LEVEL_NAMES[static_cast<int>(record.level)]);
+        _line.assign(number);
+
+        std::size_t arg = 0;
+        for (const char* c = record.format; *c; ++c) {
+            if (c[0] == '{' && c[1] == '}' && arg < record.arg_count) {
+                std::snprintf(number, sizeof(number), "%.6g",
+                        record.args[arg++]);
+                _line.append(number);
+                ++c;
+            } else {
+                _line.push_back(*c);
+            }
+        }
+        _line.push_back('\n');
+
+        std::ostream& out = record.level >= Log::Level::Warn ? std::cerr
+            : std::cout;
+        out.write(_line.data(), static_cast<std::streamsize>(_line.size()));
+    }
+
+    /// Started by the first record, stopped (drained) at exit.
+    Logger& get_logger()
+    {
+        static Logger logger;
+        return logger;
+    }
+}
+
+/**
+ * Queue a record, see Log::write() (what to call).
+ * @return False if it was dropped (queue full).
+ */
+bool Log::push(const Record& record)
+{
+    return get_logger().push(record);
+}
+
+/**
+ * Wait until everything logged so far is written (e.g., before a crash
+ * report or in a benchmark, never per frame).
+ */
+void Log::flush()
+{
+    get_logger().flush();
+}
+
+/**
+ * @return Records lost because the queue was full.
+ */
+std::size_t Log::get_dropped_count()
+{
+    return get_logger().get_dropped_count();
+}
@@ -7,11 +7,21 @@
  */
 
 #include "app.h"
+#include "trace.h"
+#include "trace-hook.h"
 
 #include <stdexcept>
 #include <iostream>
+#include <string>
 
-int main()
+/**
+ * @code
+ * occ-accessibility-tour [--record <input log> | --replay <input log>]
+ * @endcode
+ * --record writes the game's input of every tick, --replay plays a log back
+ * instead of the keyboard and voice (then closes), for repeatable perf runs.
+ */
+int main(int argc, char* argv[])
 {
     // replace atof with std::stod for cmake
     //const double input_value = std::stod(argv[1]);
@@ -23,8 +33,38 @@ int main()
         //std::cout << "Usage: " << argv[0] << " number" << std::endl;
         //return 1;
     //}
+    std::string record_filename, replay_filename;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--record" && i + 1 < argc) {
+            record_filename = argv[++i];
+        } else if (arg == "--replay" && i + 1 < argc) {
+            replay_filename = argv[++i];
+        } else {
+            std::cerr << "usage: " << argv[0]
+                << " [--record <input log> | --replay <input log>]\n";
+            return 1;
+        }
+    }
+    if (!record_filename.empty() && !replay_filename.empty()) {
+        std::cerr << "--record and --replay can't be used together\n";
+        return 1;
+    }
+
+    // before anything starts, the model loads as Application is built
+    Trace::set_thread_name("Main");
+    stt::set_trace_hook(&Trace::record);
     try {
         Application app;
+        if (!record_filename.empty() && !app.record_input(record_filename)) {
+            std::cerr << "Failed to open " << record_filename << "\n";
+            return 1;
+        }
+        if (!replay_filename.empty() && !app.replay_input(replay_filename)) {
+            std::cerr << "Failed to read input log " << replay_filename
+                << "\n";
+            return 1;
+        }
         app.run();
     } catch (std::exception& e) {
         std::cerr << "\nexception: " << e.what() << std::endl;
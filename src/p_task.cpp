@@ -1,38 +1,104 @@
 #include "p_task.h"
 
-void ParallelTask::execute()
+#include <algorithm>
+
+ParallelTask::ParallelTask() :
+    m_tasks(),
+    m_threads(),
+    m_next_task(0),
+    m_finished_tasks(0),
+    m_cancelled(false),
+    m_error()
+{}
+
+/**
+ * Tasks that have not started are dropped, running ones are waited for.
+ */
+ParallelTask::~ParallelTask()
+{
+    {
+        sf::Lock lock(m_mutex);
+        m_cancelled = true;
+    }
+    wait();
+}
+
+void ParallelTask::add_task(std::function<void ()> task)
+{
+    m_tasks.push_back(std::move(task));
+}
+
+/**
+ * Start running tasks.
+ * @param unsigned int thread_count
+ * Number of worker threads, never more than there are tasks.
+ */
+void ParallelTask::execute(unsigned int thread_count)
 {
-    m_finished = false;
-    m_elapsed_time.restart();
-    m_thread.launch();
+    std::size_t count = std::min<std::size_t>(std::max(1u, thread_count),
+            m_tasks.size());
+    for (std::size_t i = 0; i < count; ++i) {
+        m_threads.emplace_back(new sf::Thread(&ParallelTask::run_task, this));
+        m_threads.back()->launch();
+    }
 }
 
+/**
+ * Block until every worker is done.
+ */
+void ParallelTask::wait()
+{
+    for (std::unique_ptr<sf::Thread>& thread : m_threads)
+        thread->wait();
+}
+
+/**
+ * @return True once every task has run.
+ * @throw Rethrows the first exception thrown by a task.
+ */
 bool ParallelTask::is_finished()
 {
     sf::Lock lock(m_mutex);
-    return m_finished;
+    if (m_error)
+        std::rethrow_exception(m_error);
+    return m_finished_tasks == m_tasks.size();
 }
 
 float ParallelTask::get_completion()
 {
     sf::Lock lock(m_mutex);
-    // 100% at 10 sec of elapsed time, give tasks 10 sec to complete...
-    return m_elapsed_time.getElapsedTime().asSeconds() / 10.f;
+    if (m_tasks.empty())
+        return 1.f;
+    return static_cast<float>(m_finished_tasks)
+        / static_cast<float>(m_tasks.size());
 }
 
+/**
+ * Worker loop, takes the next task until there is none left (or one failed).
+ */
 void ParallelTask::run_task()
 {
-    bool ended = false;
-    while (!ended) {
-        sf::Lock lock(m_mutex); // protect the clock
-        // give tasks 10 sec to complete...
-        if (m_elapsed_time.getElapsedTime().asSeconds() >= 10.f)
-            ended = true;
-    }
+    for (;;) {
+        std::size_t index;
+        {
+            sf::Lock lock(m_mutex);
+            if (m_cancelled || m_error || m_next_task == m_tasks.size())
+                return;
+            index = m_next_task++;
+        }
 
-    // m_finished may be accessed from multiple threads -> protect it
-    {
+        // run outside of the lock, tasks are independent
+        std::exception_ptr error;
+        try {
+            m_tasks[index]();
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        // m_finished_tasks may be accessed from multiple threads -> protect it
         sf::Lock lock(m_mutex);
-        m_finished = true;
+        ++m_finished_tasks;
+        if (error && !m_error)
+            m_error = error;
     }
 }
@@ -2,17 +2,20 @@
 #include "command_queue.h"
 #include "creature.h"
 #include "task-thread.h"
+#include "trace.h"
+#include "conf.h"
+#include "utility.h"
 
 #include <map>
 #include <string>
 #include <algorithm>
 #include <iostream>
 #include <stdexcept>
+#include <cstdint>
+#include <ctime>
 
 using namespace std::placeholders;
 
-sf::Vector2f PREV_PLAYER_MOVEMENT(0.f, 0.f);
-
 struct PlayerMover {
     PlayerMover(float vx, float vy) : velocity(vx, vy) {}
     void operator() (Creature& player, sf::Time) const
@@ -36,7 +39,11 @@ struct PlayerMover {
  */
 Player::Player() :
     m_current_level_status(InProgress),
-    _stt(std::make_unique<stt::SpeechToText>())
+    // only commands are needed, spot them
+    _stt(std::make_unique<stt::SpeechToText>(stt::SpeechToText::Mode::Spot)),
+    m_actions(None),
+    m_input_recorder(),
+    m_input_replay()
 {
     /// Try to set default keyboard keybindings.
     try {
@@ -94,46 +101,124 @@ Player::Player() :
     }
 }
 
-/** To check if real-time action and not event (i.e., player wants to assign key). */
-void Player::handle_event(const sf::Event& event, CommandQueue& commands)
+/**
+ * To check if real-time action and not event (i.e., player wants to assign
+ * key). Actions are pushed at the end of the tick, see push_actions().
+ */
+void Player::handle_event(const sf::Event& event)
 {
-    if (event.type == sf::Event::KeyPressed) {
-        // check if pressed key appears in keybinding, trigger command if so
-        auto found = m_keybinding.find(event.key.code);
-        if (found != m_keybinding.end() && !is_realtime_action(found->second))
-            commands.push(m_actionbinding[found->second]);
-    }
+    if (m_input_replay.is_open() || event.type != sf::Event::KeyPressed)
+        return;
+    // check if pressed key appears in keybinding, trigger action if so
+    auto found = m_keybinding.find(event.key.code);
+    if (found != m_keybinding.end() && !is_realtime_action(found->second))
+        m_actions |= found->second;
 }
 
-void Player::handle_realtime_input(CommandQueue& commands)
+void Player::handle_realtime_input()
 {
+    if (m_input_replay.is_open())
+        return;
     /** @brief Traverses all assigned keys and checks if they are pressed. */
     for (auto pair : m_keybinding) {
-        /** @brief If key is pressed, lookup action and trigger correspoding
-         * command. */
+        /** @brief If key is pressed, add the corresponding action. */
         if (sf::Keyboard::isKeyPressed(pair.first)
                 && is_realtime_action(pair.second)) {
             // uncomment to print detection of realtime input
             //std::cout << "Realtime input detected!\n";
-            commands.push(m_actionbinding[pair.second]);
+            m_actions |= pair.second;
         }
     }
 }
 
-void Player::handle_stt_input(CommandQueue& commands)
+void Player::handle_stt_input()
 {
-    if (!_stt->key_queue_is_empty()) {
-        _stt_key = _stt->get_key();
+    if (m_input_replay.is_open())
+        return;
+    // drain every fresh key, stale ones are dropped by poll_key()
+    while (_stt->poll_key(_stt_key)) {
         for (auto pair : _sttbinding) {
             if (_stt_key == pair.first && is_realtime_action(pair.second)) {
                 // print detection of stt input
                 std::cout << "Speech to text input detected!\n";
-                commands.push(m_actionbinding[pair.second]);
+                m_actions |= pair.second;
             }
         }
     }
 }
 
+/**
+ * End the tick: its actions are recorded, or replaced by the log's when
+ * replaying, then their commands are pushed (in Action order, the same every
+ * run).
+ * @note Call once per tick, after the handle_*() of the tick.
+ * @remark An action counts once per tick, e.g., "up up" heard in one tick
+ * moves once.
+ */
+void Player::push_actions(CommandQueue& commands)
+{
+    if (m_input_replay.is_open()) {
+        std::uint32_t actions = None;
+        m_input_replay.next(actions);
+        m_actions = actions;
+    } else {
+        m_input_recorder.record(m_actions);
+    }
+
+    for (auto& [action, command] : m_actionbinding)
+        if (m_actions & action)
+            commands.push(command);
+    m_actions = None;
+}
+
+/**
+ * Record the actions of every tick of the next game session into filename,
+ * with a fresh random_int() seed.
+ * @return False if it can't be written.
+ */
+bool Player::record_input(const std::string& filename)
+{
+    auto seed = static_cast<std::uint32_t>(std::time(nullptr));
+    if (!m_input_recorder.open(filename, conf::TIME_PER_FRAME, seed))
+        return false;
+    seed_random(seed);
+    return true;
+}
+
+/**
+ * Replay the actions of filename instead of the keyboard and SpeechToText,
+ * from the first tick of the next game session, with its random_int() seed.
+ * @return False if it isn't a log recorded at this tick.
+ */
+bool Player::replay_input(const std::string& filename)
+{
+    if (!m_input_replay.open(filename, conf::TIME_PER_FRAME))
+        return false;
+    seed_random(m_input_replay.get_seed());
+    return true;
+}
+
+/**
+ * End recording or replay with the game session: a log holds one session,
+ * the next one would start from another World.
+ */
+void Player::close_input_log()
+{
+    if (m_input_recorder.is_open())
+        std::cout << "Input log closed after "
+            << m_input_recorder.get_tick_count() << " ticks\n";
+    m_input_recorder.close();
+    m_input_replay.close();
+}
+
+/**
+ * @return True once every tick of the replay was pushed.
+ */
+bool Player::is_replay_finished() const
+{
+    return m_input_replay.is_open() && m_input_replay.is_finished();
+}
+
 void Player::assign_key(Action action, sf::Keyboard::Key key)
 {
     // remove all keys that already map to action
@@ -257,15 +342,39 @@ Player::LevelStatus Player::get_level_status() const
     return m_current_level_status;
 }
 
+/**
+ * Start SpeechToText on its own thread, a run that is still going is stopped
+ * first (never two threads on one SpeechToText).
+ */
 void Player::run_stt()
 {
-    _stt_task.async([this]() { _stt->run(); });
+    _stt_task.async([this] (std::stop_token stop) {
+        Trace::set_thread_name("SpeechToText");
+        _stt->run(stop);
+    });
 }
 
-bool Player::is_stt_running()
+/**
+ * Stop SpeechToText and wait for its thread (about 100ms, one audio block).
+ */
+void Player::stop_stt()
 {
-    if (!_stt_task.async_is_finished())
-        return true;
+    _stt_task.stop();
+}
 
-    return false;
+/**
+ * @return True once the SpeechToText model is loaded, it starts loading in
+ * the background as soon as Player is constructed. Never waits.
+ */
+bool Player::is_stt_ready() const
+{
+    return _stt->is_ready();
+}
+
+/**
+ * @return True while SpeechToText runs. Never waits.
+ */
+bool Player::is_stt_running() const
+{
+    return _stt_task.is_running();
 }
@@ -0,0 +1,128 @@
+#include "profiler-overlay.h"
+#include "profiler.h"
+
+#include <SFML/Graphics/RenderTarget.hpp>
+
+#include <cstdio>
+#include <string>
+
+namespace {
+    const sf::Time REFRESH_INTERVAL = sf::seconds(0.5f);
+    const unsigned int CHARACTER_SIZE = 14;
+    const sf::Vector2f POSITION(10.f, 10.f);
+    // histograms start this far right of POSITION, bars are BAR_WIDTH wide
+    const float BARS_OFFSET = 420.f;
+    const float BAR_WIDTH = 6.f;
+    const float PADDING = 6.f;
+}
+
+ProfilerOverlay::ProfilerOverlay() :
+    m_text(),
+    m_background(),
+    m_bars(sf::Quads),
+    m_since_rebuild(sf::Time::Zero),
+    m_is_visible(false)
+{
+    m_text.setCharacterSize(CHARACTER_SIZE);
+    m_text.setPosition(POSITION);
+    m_background.setPosition(POSITION - sf::Vector2f(PADDING, PADDING));
+    m_background.setFillColor(sf::Color(0, 0, 0, 180));
+}
+
+void ProfilerOverlay::set_font(const sf::Font& font)
+{
+    m_text.setFont(font);
+}
+
+void ProfilerOverlay::toggle()
+{
+    m_is_visible = !m_is_visible;
+    if (m_is_visible)
+        rebuild();
+}
+
+bool ProfilerOverlay::is_visible() const
+{
+    return m_is_visible;
+}
+
+void ProfilerOverlay::update(sf::Time delta_time)
+{
+    if (!m_is_visible)
+        return;
+    m_since_rebuild += delta_time;
+    if (m_since_rebuild >= REFRESH_INTERVAL)
+        rebuild();
+}
+
+/**
+ * Summarize every phase into the text and the bars.
+ */
+void ProfilerOverlay::rebuild()
+{
+    m_since_rebuild = sf::Time::Zero;
+    m_bars.clear();
+
+    const sf::Font* font = m_text.getFont();
+    float line_height = font ? font->getLineSpacing(CHARACTER_SIZE)
+        : static_cast<float>(CHARACTER_SIZE);
+
+    std::string text;
+    char line[96];
+    for (int phase = 0; phase < Profiler::PhaseCount; ++phase) {
+        Profiler::Summary summary =
+            Profiler::summarize(static_cast<Profiler::Phase>(phase));
+        // World::update() phases are part of Update
+        bool is_world_phase = phase >= Profiler::Commands
+            && phase <= Profiler::AdaptView;
+        std::snprintf(line, sizeof(line),
+                "%s%-14s %6.2f  p95 %6.2f  max %6.2f\n",
+                is_world_phase ? "  " : "",
+                Profiler::get_name(static_cast<Profiler::Phase>(phase)),
+                summary.mean, summary.p95, summary.max);
+        text += line;
+
+        // bar height is the share of frames in the bucket
+        float bottom = POSITION.y + line_height * static_cast<float>(phase + 1)
+            - 2.f;
+        for (std::size_t bucket = 0; bucket < Profiler::BUCKET_COUNT;
+                ++bucket) {
+            float share = summary.count > 0
+                ? static_cast<float>(summary.buckets[bucket])
+                    / static_cast<float>(summary.count)
+                : 0.f;
+            float left = POSITION.x + BARS_OFFSET
+                + static_cast<float>(bucket) * (BAR_WIDTH + 1.f);
+            float top = bottom - share * (line_height - 4.f);
+            // slow buckets in red
+            sf::Color color = Profiler::get_bucket_limit(bucket) > 8.f
+                ? sf::Color(230, 80, 60) : sf::Color(120, 200, 120);
+            m_bars.append(sf::Vertex(sf::Vector2f(left, top), color));
+            m_bars.append(sf::Vertex(sf::Vector2f(left + BAR_WIDTH, top),
+                        color));
+            m_bars.append(sf::Vertex(sf::Vector2f(left + BAR_WIDTH, bottom),
+                        color));
+            m_bars.append(sf::Vertex(sf::Vector2f(left, bottom), color));
+        }
+    }
+    std::snprintf(line, sizeof(line),
+            "ms over the last %zu frames, buckets 0.1 to 16+ ms",
+            Profiler::WINDOW);
+    text += line;
+    m_text.setString(text);
+
+    m_background.setSize(sf::Vector2f(BARS_OFFSET + Profiler::BUCKET_COUNT
+                * (BAR_WIDTH + 1.f) + 2.f * PADDING,
+                line_height * static_cast<float>(Profiler::PhaseCount + 1)
+                + 2.f * PADDING));
+}
+
+void ProfilerOverlay::draw(sf::RenderTarget& target, sf::RenderStates states)
+    const
+{
+    if (!m_is_visible || !m_text.getFont())
+        return;
+    target.draw(m_background, states);
+    target.draw(m_text, states);
+    target.draw(m_bars, states);
+}
@@ -0,0 +1,106 @@
+#include "profiler.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace {
+    const char* const PHASE_NAMES[Profiler::PhaseCount] = {
+        "Frame",
+        "Input",
+        "Update",
+        "Commands",
+        "Collisions",
+        "Spawns",
+        "Scene update",
+        "Adapt view",
+        "Draw",
+        "Display",
+    };
+
+    // upper bounds of the histogram buckets in ms, the last bucket (above
+    // 16 ms) has none
+    constexpr float BUCKET_LIMITS[Profiler::BUCKET_COUNT - 1] = {
+        0.1f, 0.25f, 0.5f, 1.f, 2.f, 4.f, 8.f, 16.f,
+    };
+}
+
+std::array<Profiler::History, Profiler::PhaseCount> Profiler::m_histories{};
+
+/**
+ * Add a timing of phase, the oldest one of the window is dropped.
+ */
+void Profiler::record(Phase phase, Clock::duration duration)
+{
+    History& history = m_histories[phase];
+    history.samples[history.next] =
+        std::chrono::duration<float, std::milli>(duration).count();
+    history.next = (history.next + 1) % WINDOW;
+    history.count = std::min(history.count + 1, WINDOW);
+}
+
+/**
+ * @return Phase over the window, all zero if it was never recorded.
+ * @note Sorts a copy of the window, call a few times per second (e.g., the
+ * overlay), not per probe.
+ */
+Profiler::Summary Profiler::summarize(Phase phase)
+{
+    const History& history = m_histories[phase];
+    Summary summary{};
+    summary.count = history.count;
+    if (history.count == 0)
+        return summary;
+
+    std::array<float, WINDOW> sorted;
+    std::copy_n(history.samples.begin(), history.count, sorted.begin());
+    std::sort(sorted.begin(), sorted.begin() + history.count);
+
+    float total = 0.f;
+    for (std::size_t i = 0; i < history.count; ++i) {
+        total += sorted[i];
+        std::size_t bucket = 0;
+        while (bucket < BUCKET_COUNT - 1 && sorted[i] > BUCKET_LIMITS[bucket])
+            ++bucket;
+        ++summary.buckets[bucket];
+    }
+    summary.mean = total / static_cast<float>(history.count);
+    summary.p95 = sorted[(history.count - 1) * 95 / 100];
+    summary.max = sorted[history.count - 1];
+    return summary;
+}
+
+/**
+ * @return Latest timing of phase in ms, 0 if it was never recorded. For
+ * callers that keep their own, longer history (e.g., world-bench).
+ */
+float Profiler::get_last(Phase phase)
+{
+    const History& history = m_histories[phase];
+    if (history.count == 0)
+        return 0.f;
+    return history.samples[(history.next + WINDOW - 1) % WINDOW];
+}
+
+const char* Profiler::get_name(Phase phase)
+{
+    return PHASE_NAMES[phase];
+}
+
+/**
+ * @return Upper bound of bucket in ms, infinity for the last bucket (every
+ * timing above 16 ms).
+ */
+float Profiler::get_bucket_limit(std::size_t bucket)
+{
+    if (bucket >= BUCKET_COUNT - 1)
+        return std::numeric_limits<float>::infinity();
+    return BUCKET_LIMITS[bucket];
+}
+
+/**
+ * Forget every timing (e.g., after loading, which would skew the window).
+ */
+void Profiler::reset()
+{
+    m_histories = {};
+}
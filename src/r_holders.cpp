@@ -1,15 +1,92 @@
 #include "r_holders.h"
 
+#include <filesystem>
+#include <system_error>
+
 void TextureHolder::load(Textures::ID id, const std::string& filename)
 {
+    // if the file is already loaded (by another id), alias it
+    if (load_cached(id, filename) || load_packed(id, filename))
+        return;
+
     // create texture
-    std::unique_ptr<sf::Texture> texture(new sf::Texture());
+    std::shared_ptr<sf::Texture> texture(new sf::Texture());
     // load texture and evaluate if load is successful
     if (!texture->loadFromFile(filename))
         throw std::runtime_error("TextureHolder::load - Failed to load "
                 + filename);
-    // if load is successful, insert into texture map
+    // if load is successful, cache path and insert into texture map
+    m_path_cache[canonical_path(filename)] = texture;
+    insert_texture(id, std::move(texture));
+}
+
+/**
+ * Load from an image that was already decoded from filename, only the GPU
+ * upload is done here.
+ * @note Must be called from the thread that renders (OpenGL context).
+ */
+void TextureHolder::load(Textures::ID id, const std::string& filename,
+        const sf::Image& image)
+{
+    if (load_cached(id, filename))
+        return;
+
+    std::shared_ptr<sf::Texture> texture(new sf::Texture());
+    if (!texture->loadFromImage(image))
+        throw std::runtime_error("TextureHolder::load - Failed to load "
+                + filename);
+    m_path_cache[canonical_path(filename)] = texture;
+    insert_texture(id, std::move(texture));
+}
+
+/**
+ * Upload filename's pixels from the asset pack, if the pack has them.
+ * @return True if loaded, false if filename has to be loaded from its file.
+ * @note Must be called from the thread that renders (OpenGL context).
+ */
+bool TextureHolder::load_packed(Textures::ID id, const std::string& filename)
+{
+    if (!m_asset_pack)
+        return false;
+    const Pack::Entry* entry = m_asset_pack->find(filename);
+    if (!entry || entry->type != Pack::Type::Texture)
+        return false;
+
+    std::shared_ptr<sf::Texture> texture(new sf::Texture());
+    if (!texture->create(entry->width, entry->height))
+        throw std::runtime_error("TextureHolder::load_packed - Failed to load "
+                + filename);
+    texture->update(m_asset_pack->get_data(*entry));
+    m_path_cache[canonical_path(filename)] = texture;
+    insert_texture(id, std::move(texture));
+    return true;
+}
+
+/**
+ * @param const AssetPack* asset_pack
+ * Pack to look files up in first, nullptr to only load files.
+ * @warning The pack must outlive the loads (not the textures, they are
+ * copied to the GPU).
+ */
+void TextureHolder::set_asset_pack(const AssetPack* asset_pack)
+{
+    m_asset_pack = asset_pack;
+}
+
+/**
+ * Alias id to the texture of filename, if filename is already loaded.
+ * @return True if aliased, false if filename still has to be loaded.
+ */
+bool TextureHolder::load_cached(Textures::ID id, const std::string& filename)
+{
+    auto cached = m_path_cache.find(canonical_path(filename));
+    if (cached == m_path_cache.end())
+        return false;
+    std::shared_ptr<sf::Texture> texture = cached->second.lock();
+    if (!texture)
+        return false;
     insert_texture(id, std::move(texture));
+    return true;
 }
 
 template <typename Optional>
@@ -18,8 +95,10 @@ void TextureHolder::load(Textures::ID id, const std::string& filename,
 {
     // same as previous, including optional parameter
 
+    // not cached, option (e.g., area) makes it a different texture
+
     // create texture
-    std::unique_ptr<sf::Texture> texture(new sf::Texture());
+    std::shared_ptr<sf::Texture> texture(new sf::Texture());
     // load texture and evaluate if load is successful
     if (!texture->loadFromFile(filename, option))
         throw std::runtime_error("TextureHolder::load - Failed to load "
@@ -28,6 +107,31 @@ void TextureHolder::load(Textures::ID id, const std::string& filename,
     insert_texture(id, std::move(texture));
 }
 
+/**
+ * Release the texture of an id. The texture is freed once no other id
+ * aliases it.
+ */
+void TextureHolder::release(Textures::ID id)
+{
+    m_texture_map.erase(id);
+
+    // drop cache entries whose texture was freed
+    for (auto it = m_path_cache.begin(); it != m_path_cache.end(); ) {
+        if (it->second.expired())
+            it = m_path_cache.erase(it);
+        else
+            ++it;
+    }
+}
+
+/**
+ * @return True if a texture is loaded for id.
+ */
+bool TextureHolder::contains(Textures::ID id) const
+{
+    return m_texture_map.find(id) != m_texture_map.end();
+}
+
 sf::Texture& TextureHolder::get(Textures::ID id)
 {
     // if found, will recieve id and confirm. if not, recieve end() & assert
@@ -49,7 +153,7 @@ const sf::Texture& TextureHolder::get(Textures::ID id) const
 }
 
 void TextureHolder::insert_texture(Textures::ID id,
-        std::unique_ptr<sf::Texture> texture)
+        std::shared_ptr<sf::Texture> texture)
 {
     auto inserted = m_texture_map.insert(std::make_pair(id,
                 std::move(texture)));
@@ -57,18 +161,49 @@ void TextureHolder::insert_texture(Textures::ID id,
     assert(inserted.second);
 }
 
+/**
+ * @return Canonical form of filename, so different spellings of the same
+ * file share a cache entry.
+ * @note Falls back to filename as given if it can't be resolved.
+ */
+std::string TextureHolder::canonical_path(const std::string& filename)
+{
+    std::error_code error;
+    std::filesystem::path path = std::filesystem::weakly_canonical(filename,
+            error);
+    if (error)
+        return filename;
+    return path.string();
+}
+
 void FontHolder::load(Fonts::ID id, const std::string& filename)
 {
     // create font
     std::unique_ptr<sf::Font> font(new sf::Font());
-    // load font and evaluate if load is successful
-    if (!font->loadFromFile(filename))
+    // load font from the asset pack if it has it, or from the file
+    const Pack::Entry* entry = m_asset_pack ? m_asset_pack->find(filename)
+        : nullptr;
+    bool loaded = entry && entry->type == Pack::Type::Font
+        ? font->loadFromMemory(m_asset_pack->get_data(*entry), entry->size)
+        : font->loadFromFile(filename);
+    // evaluate if load is successful
+    if (!loaded)
         throw std::runtime_error("FontHolder::load - Failed to load "
                 + filename);
     // if load is successful, insert into texture map
     insert_font(id, std::move(font));
 }
 
+/**
+ * @param const AssetPack* asset_pack
+ * Pack to look fonts up in first, nullptr to only load files.
+ * @warning sf::Font reads from memory lazily, the pack must outlive the fonts.
+ */
+void FontHolder::set_asset_pack(const AssetPack* asset_pack)
+{
+    m_asset_pack = asset_pack;
+}
+
 sf::Font& FontHolder::get(Fonts::ID id)
 {
     // if found, will recieve id and confirm. if not, recieve end() & assert
@@ -5,7 +5,7 @@
 
 GameState::GameState(StateStack& stack, Context context) :
     State(stack, context),
-    m_world(*context.window, *context.fonts),
+    m_world(context.window, *context.textures, *context.fonts),
     m_player(*context.player),
     _stt_start(true)
 {
@@ -24,7 +24,8 @@ bool GameState::update(sf::Time delta_time)
 {
     // xxx game state is updating, meaning stt should be running...
     // run on separate thread and don't run again until thread has completed
-    if (_stt_start) {
+    // (started once the model is loaded, its load began with the Application)
+    if (_stt_start && m_player.is_stt_ready()) {
         m_player.run_stt();
         std::cout << "Creating thread...\n";
         _stt_start = false;
@@ -34,19 +35,26 @@ bool GameState::update(sf::Time delta_time)
     m_world.update(delta_time);
     /// Get commands from command queue, then handle input.
     CommandQueue& commands = m_world.get_command_queue();
-    m_player.handle_realtime_input(commands);
-    m_player.handle_stt_input(commands);
+    m_player.handle_realtime_input();
+    m_player.handle_stt_input();
     // uncomment to print if game update loop is handling realtime input
     //std::cout << "Game update loop: Receiving realtimesttt!\n";
+    /// Recorded, or replayed, per tick from here.
+    m_player.push_actions(commands);
+
+    /// A replay is over, close the game (perf runs end on their own).
+    if (m_player.is_replay_finished()) {
+        std::cout << "Replay finished, closing\n";
+        request_clear_state();
+    }
 
     return true;
 }
 
 bool GameState::handle_event(const sf::Event& event)
 {
-    // game input handling
-    CommandQueue& commands = m_world.get_command_queue();
-    m_player.handle_event(event, commands);
+    // game input handling, pushed with the tick's other actions
+    m_player.handle_event(event);
 
     /// If escape pressed, push pause state as current state.
     if (event.type == sf::Event::KeyPressed
@@ -61,8 +69,14 @@ bool GameState::handle_event(const sf::Event& event)
     return true;
 }
 
+/**
+ * SpeechToText is stopped and its thread joined, entering the game again
+ * starts a new one. An input log only holds this session, it is closed.
+ */
 GameState::~GameState()
 {
+    m_player.stop_stt();
+    m_player.close_input_log();
     std::cout << "Game state has been destroyed!" << std::endl;
 }
 
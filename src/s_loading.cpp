@@ -1,12 +1,19 @@
 #include "s_loading.h"
 #include "utility.h"
 #include "r_holders.h"
+#include "world.h"
 
 #include <SFML/Graphics/RenderWindow.hpp>
 #include <SFML/Graphics/View.hpp>
 
+namespace {
+    // GPU uploads per frame, keeps the progress bar drawing while uploading
+    constexpr std::size_t UPLOADS_PER_FRAME = 2;
+}
+
 LoadingState::LoadingState(StateStack& stack, Context context) :
-    State(stack, context)
+    State(stack, context),
+    m_texture_loader(*context.textures)
 {
     // get &render window from context
     sf::RenderWindow& window = *get_context().window;
@@ -36,8 +43,10 @@ LoadingState::LoadingState(StateStack& stack, Context context) :
     // completion %
     set_completion(0.f);
 
-    // exec loading as parallel task
-    m_loading_task.execute();
+    // decode the world's textures on worker threads, textures that are
+    // already loaded (e.g., coming back from the menu) are skipped
+    World::queue_textures(m_texture_loader);
+    m_texture_loader.launch();
 }
 
 void LoadingState::draw()
@@ -55,12 +64,13 @@ void LoadingState::draw()
 bool LoadingState::update(sf::Time delta_time)
 {
     // loading -> delta time not needed, not game logic
-    // update progress bar from parallel task or finish loading
-    if (m_loading_task.is_finished()) {
+    // upload what is decoded, then update progress bar or finish loading
+    m_texture_loader.upload(UPLOADS_PER_FRAME);
+    if (m_texture_loader.is_finished()) {
         request_pop_stack();
         request_push_stack(States::Game);
     } else {
-        set_completion(m_loading_task.get_completion());
+        set_completion(m_texture_loader.get_completion());
     }
 
     return true;
@@ -5,8 +5,6 @@
 #include <SFML/Graphics/RenderWindow.hpp>
 #include <SFML/Graphics/View.hpp>
 
-#include <pthread.h>
-
 #include <iostream>
 #include <thread>
 
@@ -14,7 +12,7 @@ MenuState::MenuState(StateStack& stack, Context context) :
     State(stack, context),
     m_options(),
     m_options_index(0),
-    _stt(std::make_unique<stt::SpeechToText>()),
+    _stt(std::make_unique<stt::SpeechToText>(stt::SpeechToText::Mode::Spot)),
     _stt_start(true),
     _th()
 {
@@ -132,9 +130,10 @@ bool MenuState::handle_event(const sf::Event& event)
     if (event.key.code == sf::Keyboard::Return) {
         if(m_options_index == Play) {
             // if play is pressed ->
-            // pop off menu state & push game state to top of stack
+            // pop off menu state & push loading state to top of stack,
+            // loading pushes the game state once the world is loaded
             request_pop_stack();
-            request_push_stack(States::Game);
+            request_push_stack(States::Loading);
         } else if (m_options_index == Settings) {
             request_push_stack(States::Settings);
         } else if (m_options_index == Exit) {
@@ -149,7 +149,7 @@ void SettingsState::gui_frame()
     // button layout
     ImGui::SetCursorPos(centered); // set starting pos of button
     if (ImGui::Button("Play", buttons.vec2)) {
-        request_push_stack(States::Game);
+        request_push_stack(States::Loading);
     }
 
     // next button y centered += 1 * (height + spacing) -> & so on...
@@ -1,10 +1,12 @@
 #include "s_stack.h"
+#include "trace.h"
 
 #include <cassert>
 
 StateStack::StateStack(State::Context context) :
     m_stack(),
     m_pending_list(),
+    m_change_count(0),
     m_context(context),
     m_factories()
 {}
@@ -82,6 +84,15 @@ bool StateStack::is_empty() const
     return m_stack.empty();
 }
 
+/**
+ * @return Times the stack was changed (push, pop, clear), to tell frames that
+ * built or destroyed a state (e.g., the World) from the others.
+ */
+std::size_t StateStack::get_change_count() const
+{
+    return m_change_count;
+}
+
 StateStack::PendingChange::PendingChange(Action action, States::ID state_id) :
     action(action),
     state_id(state_id)
@@ -91,6 +102,9 @@ StateStack::PendingChange::PendingChange(Action action, States::ID state_id) :
 // PendingAction list first so that they can be handled safely
 void StateStack::apply_pending_changes()
 {
+    TraceScope scope("StateStack::apply_pending_changes");
+    if (!m_pending_list.empty())
+        ++m_change_count;
     // it through PendingChange list before manip stack to safely not lose
     // actions
     for (PendingChange change : m_pending_list) {
@@ -2,6 +2,8 @@
 #include "command.h"
 #include "utility.h"
 #include "command_queue.h"
+#include "collision-grid.h"
+#include "static-colliders.h"
 
 /// RenderTarget, RectangleShape, and Color only needed locally for the
 /// implementation of get_bounding_rect().
@@ -13,19 +15,40 @@
 #include <cassert>
 #include <cmath>
 
+namespace {
+    /// Union of two rects, an empty rect (no size) doesn't grow the union.
+    sf::FloatRect unite(const sf::FloatRect& lhs, const sf::FloatRect& rhs)
+    {
+        if (rhs.width <= 0.f || rhs.height <= 0.f)
+            return lhs;
+        if (lhs.width <= 0.f || lhs.height <= 0.f)
+            return rhs;
+        float left = std::min(lhs.left, rhs.left);
+        float top = std::min(lhs.top, rhs.top);
+        float right = std::max(lhs.left + lhs.width, rhs.left + rhs.width);
+        float bottom = std::max(lhs.top + lhs.height, rhs.top + rhs.height);
+        return sf::FloatRect(left, top, right - left, bottom - top);
+    }
+}
+
 /**
- * @note Collision between nodes on the scene graph are checked by (1) checking
- * the entire scene graph for collisions, (2) filling a set with collision pairs,
- * and (3) iterating through the set to differentiate between the collision's
- * categories
+ * @note Collision between nodes on the scene graph are checked by (1)
+ * registering collidable nodes in a CollisionGrid, (2) filling a vector with
+ * collision pairs from nodes sharing a grid cell, and (3) iterating through the
+ * vector to differentiate between the collision's categories
  */
 SceneNode::SceneNode(Category::Type category) :
-    m_children(), m_parent(nullptr), m_default_category(category) {}
+    m_children(), m_parent(nullptr), m_default_category(category),
+    m_world_transform(), m_is_world_transform_dirty(true),
+    m_subtree_bounds(), m_is_subtree_bounds_dirty(true) {}
 // https://stackoverflow.com/questions/45583473/include-errors-detected-in-vscode
 
 void SceneNode::attach_child(Ptr child) {
     child->m_parent = this;
+    // new parent, new absolute transform
+    child->invalidate_world_transform();
     m_children.push_back(std::move(child));
+    invalidate_bounds();
 }
 
 // attach child node via setting parent pointer to curr node
@@ -42,7 +65,9 @@ SceneNode::Ptr SceneNode::detach_child(const SceneNode& node)
     // erase node's parent pointer from container and -> nullptr
     Ptr result = std::move(*found);
     result->m_parent = nullptr;
+    result->invalidate_world_transform();
     m_children.erase(found);
+    invalidate_bounds();
     return result;
 }
 
@@ -92,15 +117,40 @@ void SceneNode::draw_children(sf::RenderTarget& target, sf::RenderStates states)
         child->draw(target, states);
 }
 
+/**
+ * Same as draw(), but skips every subtree whose bounds are outside of the
+ * view, so only visible nodes issue draw calls.
+ * @param const sf::FloatRect& view_bounds
+ * World coordinates of the current view (e.g., World::get_view_bounds()).
+ */
+void SceneNode::draw_culled(sf::RenderTarget& target,
+        const sf::FloatRect& view_bounds, sf::RenderStates states) const
+{
+    if (!view_bounds.intersects(get_subtree_bounds()))
+        return;
+
+    states.transform *= getTransform();
+    draw_current(target, states);
+    for (const Ptr& child : m_children)
+        child->draw_culled(target, view_bounds, states);
+}
+
 // absolute transformation functions ->
-sf::Transform SceneNode::get_world_transform() const
+/**
+ * @return Returns the absolute transform of the node.
+ * @note Cached, the parent chain is only walked (and multiplied) again after
+ * the node or one of its ancestors was moved.
+ */
+const sf::Transform& SceneNode::get_world_transform() const
 {
-    sf::Transform transform = sf::Transform::Identity;
-    // loop to ittr & apply transforms?
-    // TODO: rewrite/figure out more
-    for (const SceneNode* node = this; node != nullptr; node = node->m_parent)
-            transform = node->getTransform() * transform;
-    return transform;
+    if (m_is_world_transform_dirty) {
+        if (m_parent != nullptr)
+            m_world_transform = m_parent->get_world_transform() * getTransform();
+        else
+            m_world_transform = getTransform();
+        m_is_world_transform_dirty = false;
+    }
+    return m_world_transform;
 }
 
 sf::Vector2f SceneNode::get_world_position() const
@@ -108,6 +158,113 @@ sf::Vector2f SceneNode::get_world_position() const
     return get_world_transform() * sf::Vector2f();
 }
 
+/**
+ * Mark the cached world transform of the node and its children as dirty.
+ * @note Stops at a node that is already dirty, its children are dirty too.
+ */
+void SceneNode::invalidate_world_transform()
+{
+    if (m_is_world_transform_dirty)
+        return;
+    m_is_world_transform_dirty = true;
+    // bounds are in world coordinates, they move with the transform
+    m_is_subtree_bounds_dirty = true;
+    for (Ptr& child : m_children)
+        child->invalidate_world_transform();
+}
+
+/**
+ * Mark the cached subtree bounds of the node and its ancestors as dirty.
+ * @note Stops at an ancestor that is already dirty, its ancestors are dirty
+ * too.
+ */
+void SceneNode::invalidate_bounds()
+{
+    m_is_subtree_bounds_dirty = true;
+    for (SceneNode* node = m_parent;
+            node != nullptr && !node->m_is_subtree_bounds_dirty;
+            node = node->m_parent)
+        node->m_is_subtree_bounds_dirty = true;
+}
+
+/// Hidden sf::Transformable mutators, forward and invalidate if changed ->
+void SceneNode::setPosition(float x, float y)
+{
+    setPosition(sf::Vector2f(x, y));
+}
+
+void SceneNode::setPosition(const sf::Vector2f& position)
+{
+    if (position == getPosition())
+        return;
+    sf::Transformable::setPosition(position);
+    invalidate_world_transform();
+    invalidate_bounds();
+}
+
+void SceneNode::setRotation(float angle)
+{
+    if (angle == getRotation())
+        return;
+    sf::Transformable::setRotation(angle);
+    invalidate_world_transform();
+    invalidate_bounds();
+}
+
+void SceneNode::setScale(float factor_x, float factor_y)
+{
+    setScale(sf::Vector2f(factor_x, factor_y));
+}
+
+void SceneNode::setScale(const sf::Vector2f& factors)
+{
+    if (factors == getScale())
+        return;
+    sf::Transformable::setScale(factors);
+    invalidate_world_transform();
+    invalidate_bounds();
+}
+
+void SceneNode::setOrigin(float x, float y)
+{
+    setOrigin(sf::Vector2f(x, y));
+}
+
+void SceneNode::setOrigin(const sf::Vector2f& origin)
+{
+    if (origin == getOrigin())
+        return;
+    sf::Transformable::setOrigin(origin);
+    invalidate_world_transform();
+    invalidate_bounds();
+}
+
+void SceneNode::move(float offset_x, float offset_y)
+{
+    move(sf::Vector2f(offset_x, offset_y));
+}
+
+void SceneNode::move(const sf::Vector2f& offset)
+{
+    setPosition(getPosition() + offset);
+}
+
+void SceneNode::rotate(float angle)
+{
+    setRotation(getRotation() + angle);
+}
+
+void SceneNode::scale(float factor_x, float factor_y)
+{
+    scale(sf::Vector2f(factor_x, factor_y));
+}
+
+void SceneNode::scale(const sf::Vector2f& factor)
+{
+    const sf::Vector2f& current = getScale();
+    setScale(current.x * factor.x, current.y * factor.y);
+}
+
 /**
  * @return Returns category of scene node.
  * @note Default category is Category::SceneGroundLayer.
@@ -149,39 +306,31 @@ void SceneNode::draw_bounding_rect(sf::RenderTarget& target,
 }
 
 /**
- * Checks the entire scene graph against one node for collisions.
- * @remark O(n^2) complexity, can be optimized.
- * @todo Implement by placing enemies in a grid and check collisions with
- * adjacent grid cells - will improve optimization.
+ * Registers this node and its children in the collision broad phase.
+ * @note Only nodes in Category::Collidable are registered, layer nodes,
+ * scenery and text never collide and are skipped. Static nodes are skipped
+ * too, they are registered once with register_static_colliders().
+ * @see CollisionGrid::find_pairs() to get the colliding pairs.
  */
-void SceneNode::check_node_collision(SceneNode& node,
-        std::set<Pair>& collision_pairs)
-{
-    // caller != param, collision between caller & param, caller is not
-    // destroyed, & param is not destroyed
-    if (this != &node && collision(*this, node)
-           && !is_destroyed() && !node.is_destroyed()) {
-        /// collision_pairs is a map containing nodes with collision - insert
-        /// into map. std::minmax() orders the map so that pairs are in an
-        /// expected order, and there's no duplicate pairs.
-        collision_pairs.insert(std::minmax(this, &node));
-    }
-    /// Recursively calls itself to iterate through all collision pairs for the
-    /// calling node and its children.
+void SceneNode::register_colliders(CollisionGrid& grid)
+{
+    if (get_category() & Category::Collidable && !is_static())
+        grid.insert(*this);
     for (Ptr& child : m_children)
-        child->check_node_collision(node, collision_pairs);
+        child->register_colliders(grid);
 }
 
 /**
- * Checks the whole scene graph against all nodes for collision.
- * @note Uses check_node_collision() and iterates over entire scene graph.
+ * Registers this node and its children, if they never move, in the static
+ * collider store.
+ * @see register_colliders() for the moving nodes.
  */
-void SceneNode::check_scene_collision(SceneNode& scene_graph,
-        std::set<Pair>& collision_pairs)
+void SceneNode::register_static_colliders(StaticColliders& colliders)
 {
-    check_node_collision(scene_graph, collision_pairs);
-    for (Ptr& child : scene_graph.m_children)
-        check_scene_collision(*child, collision_pairs);
+    if (get_category() & Category::Collidable && is_static())
+        colliders.insert(*this);
+    for (Ptr& child : m_children)
+        child->register_static_colliders(colliders);
 }
 
 /**
@@ -202,6 +351,16 @@ bool SceneNode::is_destroyed() const
     return false;
 }
 
+/**
+ * Virtual fn for derived class(es) that never move to implement.
+ * @return Returns true if the node never moves after being spawned.
+ */
+bool SceneNode::is_static() const
+{
+    /// By default, scene node can move.
+    return false;
+}
+
 /**
  * Removal routine.
  * @if is_marked_for_removal().
@@ -217,7 +376,10 @@ void SceneNode::removal()
     auto removal_begin = std::remove_if(m_children.begin(), m_children.end(),
             std::mem_fn(&SceneNode::is_marked_for_removal));
     /// Erases the SceneNode::Ptr objects to be removed.
-    m_children.erase(removal_begin, m_children.end());
+    if (removal_begin != m_children.end()) {
+        m_children.erase(removal_begin, m_children.end());
+        invalidate_bounds();
+    }
     /// Recursive fn call to create a fn object for each node marked for removal
     /// - fn object to be used in World::update.
     std::for_each(m_children.begin(), m_children.end(),
@@ -232,6 +394,24 @@ sf::FloatRect SceneNode::get_bounding_rect() const
     return sf::FloatRect();
 }
 
+/**
+ * @return Returns the union of the bounding rects of the node and all its
+ * children (world coordinates).
+ * @note Cached, only recomputed after something in the subtree moved or
+ * changed its bounds.
+ */
+const sf::FloatRect& SceneNode::get_subtree_bounds() const
+{
+    if (m_is_subtree_bounds_dirty) {
+        sf::FloatRect bounds = get_bounding_rect();
+        for (const Ptr& child : m_children)
+            bounds = unite(bounds, child->get_subtree_bounds());
+        m_subtree_bounds = bounds;
+        m_is_subtree_bounds_dirty = false;
+    }
+    return m_subtree_bounds;
+}
+
 /*
  * Checks collisions between bounding rectangles in the scene graph.
  * @note Not implemented in Entity class because collisions occur in the scene
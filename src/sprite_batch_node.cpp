@@ -0,0 +1,103 @@
+#include "sprite_batch_node.h"
+
+#include <SFML/Graphics/RenderTarget.hpp>
+
+#include <algorithm>
+
+SpriteBatchNode::SpriteBatchNode() :
+    m_batches(),
+    m_local_bounds()
+{}
+
+/**
+ * Append one sprite to the batch of its texture.
+ * @param const sf::Texture& texture
+ * Texture sampled by the sprite, sprites with the same texture share a batch.
+ * @param const sf::IntRect& texture_rect
+ * Sub-rectangle of the texture (e.g., an atlas entry).
+ * @param const sf::Transform& transform
+ * Transform of the sprite relative to the batch node, what the sprite's
+ * sf::Transformable would have been.
+ * @note Vertices are computed here once, nothing is recomputed per frame.
+ */
+void SpriteBatchNode::add_sprite(const sf::Texture& texture,
+        const sf::IntRect& texture_rect, const sf::Transform& transform)
+{
+    auto found = std::find_if(m_batches.begin(), m_batches.end(),
+            [&] (const Batch& batch) { return batch.texture == &texture; });
+    if (found == m_batches.end()) {
+        m_batches.push_back(Batch{&texture, sf::VertexArray(sf::Triangles)});
+        found = m_batches.end() - 1;
+    }
+
+    float width = static_cast<float>(texture_rect.width);
+    float height = static_cast<float>(texture_rect.height);
+    float left = static_cast<float>(texture_rect.left);
+    float top = static_cast<float>(texture_rect.top);
+
+    // corners: top-left, top-right, bottom-right, bottom-left
+    sf::Vertex quad[4] = {
+        sf::Vertex(transform.transformPoint(0.f, 0.f),
+                sf::Vector2f(left, top)),
+        sf::Vertex(transform.transformPoint(width, 0.f),
+                sf::Vector2f(left + width, top)),
+        sf::Vertex(transform.transformPoint(width, height),
+                sf::Vector2f(left + width, top + height)),
+        sf::Vertex(transform.transformPoint(0.f, height),
+                sf::Vector2f(left, top + height)),
+    };
+
+    // two triangles per quad
+    sf::VertexArray& vertices = found->vertices;
+    vertices.append(quad[0]);
+    vertices.append(quad[1]);
+    vertices.append(quad[2]);
+    vertices.append(quad[0]);
+    vertices.append(quad[2]);
+    vertices.append(quad[3]);
+
+    // grow local bounds by the quad
+    sf::FloatRect rect = transform.transformRect(
+            sf::FloatRect(0.f, 0.f, width, height));
+    if (m_local_bounds.width <= 0.f || m_local_bounds.height <= 0.f) {
+        m_local_bounds = rect;
+    } else {
+        float right = std::max(m_local_bounds.left + m_local_bounds.width,
+                rect.left + rect.width);
+        float bottom = std::max(m_local_bounds.top + m_local_bounds.height,
+                rect.top + rect.height);
+        m_local_bounds.left = std::min(m_local_bounds.left, rect.left);
+        m_local_bounds.top = std::min(m_local_bounds.top, rect.top);
+        m_local_bounds.width = right - m_local_bounds.left;
+        m_local_bounds.height = bottom - m_local_bounds.top;
+    }
+    invalidate_bounds();
+}
+
+/**
+ * Remove every sprite, to rebuild the batch when the static set changes.
+ */
+void SpriteBatchNode::clear()
+{
+    m_batches.clear();
+    m_local_bounds = sf::FloatRect();
+    invalidate_bounds();
+}
+
+/**
+ * @return Returns the bounding rectangle of all batched sprites, used for
+ * culling.
+ */
+sf::FloatRect SpriteBatchNode::get_bounding_rect() const
+{
+    return get_world_transform().transformRect(m_local_bounds);
+}
+
+void SpriteBatchNode::draw_current(sf::RenderTarget& target,
+        sf::RenderStates states) const
+{
+    for (const Batch& batch : m_batches) {
+        states.texture = batch.texture;
+        target.draw(batch.vertices, states);
+    }
+}
@@ -24,4 +24,13 @@ void SpriteNode::center_origin()
 	sf::FloatRect bounds = m_sprite.getGlobalBounds();
 	m_sprite.setOrigin(std::floor(bounds.left + bounds.width / 2.f),
             std::floor(bounds.top + bounds.height / 2.f));
+    invalidate_bounds();
+}
+
+/**
+ * @return Returns the bounding rectangle of the sprite, used for culling.
+ */
+sf::FloatRect SpriteNode::get_bounding_rect() const
+{
+    return get_world_transform().transformRect(m_sprite.getGlobalBounds());
 }
@@ -0,0 +1,68 @@
+#include "static-colliders.h"
+
+#include <algorithm>
+
+void StaticColliders::clear()
+{
+    m_colliders.clear();
+    m_max_width = 0.f;
+}
+
+/**
+ * Add a static node, its bounding rectangle is computed here and not again.
+ * @note Call build() after all nodes are inserted.
+ */
+void StaticColliders::insert(SceneNode& node)
+{
+    sf::FloatRect rect = node.get_bounding_rect();
+    if (rect.width <= 0.f || rect.height <= 0.f)
+        return;
+
+    m_colliders.push_back(Collider{&node, rect});
+    m_max_width = std::max(m_max_width, rect.width);
+}
+
+/**
+ * Sort colliders by left edge, to be queried.
+ */
+void StaticColliders::build()
+{
+    std::sort(m_colliders.begin(), m_colliders.end(),
+            [] (const Collider& lhs, const Collider& rhs) {
+        return lhs.rect.left < rhs.rect.left;
+    });
+}
+
+/**
+ * Append a pair for every static collider intersecting a (moving) node.
+ * @param SceneNode& node
+ * The moving node.
+ * @param const sf::FloatRect& rect
+ * Bounding rectangle of the moving node, already computed by the caller.
+ * @param std::vector<SceneNode::Pair>& collision_pairs
+ * Output, pairs are ordered with std::minmax() like CollisionGrid's.
+ */
+void StaticColliders::query(SceneNode& node, const sf::FloatRect& rect,
+        std::vector<SceneNode::Pair>& collision_pairs) const
+{
+    /// Nothing starting left of (rect.left - widest collider) can reach rect.
+    float first_left = rect.left - m_max_width;
+    float last_left = rect.left + rect.width;
+    auto it = std::lower_bound(m_colliders.begin(), m_colliders.end(),
+            first_left, [] (const Collider& collider, float left) {
+        return collider.rect.left < left;
+    });
+    for (; it != m_colliders.end() && it->rect.left <= last_left; ++it) {
+        if (it->node == &node || !rect.intersects(it->rect))
+            continue;
+        collision_pairs.push_back(std::minmax(&node, it->node));
+    }
+}
+
+/**
+ * @return Number of static colliders.
+ */
+std::size_t StaticColliders::size() const
+{
+    return m_colliders.size();
+}
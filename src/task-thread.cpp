@@ -1,131 +1,93 @@
 #include "task-thread.h"
 
-#include <pthread.h>
-#include <signal.h>
-
-#include <iostream>
-
-// xxx is instantiating thread in constructor going to have issues? LOOK INTO!
 TaskThread::TaskThread() :
-    _wakeup(false),
-    _stop(false),
-    _th()
-    // xxx _th should already be instantiated upon object creation (?) others?
+    _th(),
+    _running(false),
+    _error(),
+    _mtx()
 {}
 
-// xxx review sfml game-dev book for implentation of locking
-// xxx template<typename ReturnType>
 /**
- * Private method that accepts a std::packaged_task function and invokes it.
+ * Private method that runs the task on _th, keeps what it throws for
+ * is_finished().
  */
-template <typename ReturnType>
-void TaskThread::run_task(std::packaged_task<ReturnType ()>&& task)
+void TaskThread::run_task(std::stop_token stop,
+        std::function<void (std::stop_token)> task)
 {
-    task();
+    try {
+        task(stop);
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(_mtx);
+        _error = std::current_exception();
+    }
+    _running = false;
 }
 
 /**
- * Run bool async Task (return FALSE when finished).
- * @note Pass void anonymous function (as lambda), but std::packaged_task 
- * expects bool. Underlying expected function is bool.
+ * Run task on the thread, a task that is still running is stopped (and
+ * joined) first.
+ * @param std::function<void (std::stop_token)> task
+ * Should return soon after the token is asked to stop.
  */
-void TaskThread::async(std::function<void ()> task)
+void TaskThread::async(std::function<void (std::stop_token)> task)
 {
-    // assume task completion means TRUE
-    std::packaged_task<bool ()> ptask([task]() -> bool {
-        // xxx maybe want this?
-        //if (task_) {
-        //    task_(); // Execute the task if it's not empty
-        //    return true;
-        //} else {
-        //    return false; // Return false if the task is empty
-        //}
-
-        task();
-        return true;
+    stop();
+    _running = true;
+    _th = std::jthread([this, task = std::move(task)] (std::stop_token stop) {
+        run_task(stop, task);
     });
-
-    _fut = ptask.get_future();
-    /// xxx 2 threads of no? look into (!)
-    _th = std::thread(&TaskThread::run_task<bool>, this, std::move(ptask));
-    _th.detach();
-
-    /// xxx look into this (?)
-    //{
-    //    auto lock = std::unique_lock<std::mutex>(_mtx);
-    //    _finished = false;
-    //}
 }
 
 /**
- * @return TRUE if async Task is finished.
+ * @return True while the task runs. Never waits.
  */
-bool TaskThread::async_is_finished()
+bool TaskThread::is_running() const
 {
-    auto lock = std::unique_lock<std::mutex>(_mtx);
-    if (_fut.get() != false)
-        return false;
-
-    return true;
+    return _running;
 }
 
 /**
- * Wakeup TaskThread.
+ * @return True once the task returned (or if there never was one). Never
+ * waits.
+ * @throw Rethrows what the task threw, once.
  */
-void TaskThread::wakeup() 
-{
-    auto lock = std::unique_lock<std::mutex>(_wakemtx);
-    _wakeup = true;
-    _wakecond.notify_one();
-}
-
-/**
-* Wait for TaskThread to complete.
-*/
-void TaskThread::wait() 
+bool TaskThread::is_finished()
 {
-    auto lock = std::unique_lock<std::mutex>(_waitmtx);
-    while (_wakeup) {
-        _wakecond.wait(lock);
+    if (_running)
+        return false;
+    std::exception_ptr error;
+    {
+        std::lock_guard<std::mutex> lock(_mtx);
+        std::swap(error, _error);
     }
+    if (error)
+        std::rethrow_exception(error);
+    return true;
 }
 
 /**
-* Ask the TaskThread to stop.
-*/
-void TaskThread::stop() 
+ * Ask the task to stop, without waiting for it.
+ */
+void TaskThread::request_stop()
 {
-    auto lock = std::unique_lock<std::mutex>(_wakemtx);
-    _stop = true;
-    _wakecond.notify_one();
+    _th.request_stop();
 }
 
 /**
-* Join the TaskThread (wait for it to stop and join).
-*/
-void TaskThread::join()
-{
-    _th.join();
-}
-
-/** 
- * @warning Native kill procedure only! (Linux)
- * Call native kill procedure (pthread_kill()).
+ * Ask the task to stop and join the thread (waits for the task to return).
  */
-void TaskThread::native_cancel()
+void TaskThread::stop()
 {
-    pthread_t pth = _th.native_handle();
-    std::cout << "Native handle of thread recieved!\n"
-        << "Sending SIGKILL to thread...\n";
-    //pthread_kill(pth, SIGKILL);
-    pthread_cancel(NULL);
+    if (!_th.joinable())
+        return;
+    _th.request_stop();
+    _th.join();
 }
 
 /**
-* Upon object destruction, cleanup and join thread back to main.
-*/
+ * Upon object destruction, stop the task and join thread back to main.
+ */
 TaskThread::~TaskThread()
 {
-    if (_th.joinable())
-        _th.join();
+    stop();
 }
@@ -27,8 +27,12 @@ void TextNode::draw_current(sf::RenderTarget& target, sf::RenderStates states)
  */
 void TextNode::set_string(const std::string& text)
 {
+    // Creature sets its text every update, skip re-centering unchanged text
+    if (m_text.getString() == text)
+        return;
     m_text.setString(text);
     center_origin(m_text);
+    invalidate_bounds();
 }
 
 /**
@@ -66,7 +70,10 @@ void TextNode::set_outline_color(const sf::Color& color)
 */
 void TextNode::set_outline_thickness(float thickness)
 {
+    if (m_text.getOutlineThickness() == thickness)
+        return;
     m_text.setOutlineThickness(thickness);
+    invalidate_bounds();
 }
 
 /**
@@ -74,7 +81,10 @@ void TextNode::set_outline_thickness(float thickness)
 */
 void TextNode::set_character_size(unsigned int size)
 {
+    if (m_text.getCharacterSize() == size)
+        return;
     m_text.setCharacterSize(size);
+    invalidate_bounds();
 }
 
 /**
@@ -83,5 +93,16 @@ void TextNode::set_character_size(unsigned int size)
 */
 void TextNode::set_style(std::uint32_t style)
 {
+    if (m_text.getStyle() == style)
+        return;
     m_text.setStyle(style);
+    invalidate_bounds();
+}
+
+/**
+ * @return Returns the bounding rectangle of the text, used for culling.
+ */
+sf::FloatRect TextNode::get_bounding_rect() const
+{
+    return get_world_transform().transformRect(m_text.getGlobalBounds());
 }
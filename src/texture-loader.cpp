@@ -0,0 +1,151 @@
+#include "texture-loader.h"
+#include "trace.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+
+TextureLoader::TextureLoader(TextureHolder& textures) :
+    m_textures(textures),
+    m_jobs(),
+    m_decoded_count(0),
+    m_uploaded_count(0),
+    m_decoding()
+{}
+
+/**
+ * Workers that are still decoding stop after their current file.
+ */
+TextureLoader::~TextureLoader() = default;
+
+/**
+ * Add a texture to load.
+ * @note Queue everything before launch(). IDs already in the holder, and
+ * files the holder already has, are not decoded again. Files in the holder's
+ * asset pack are uploaded right away, they need no decoding.
+ */
+void TextureLoader::queue(Textures::ID id, const std::string& filename)
+{
+    if (m_textures.contains(id) || m_textures.load_cached(id, filename)
+            || m_textures.load_packed(id, filename))
+        return;
+
+    auto found = std::find_if(m_jobs.begin(), m_jobs.end(),
+            [&] (const std::unique_ptr<Job>& job) {
+        return job->filename == filename;
+    });
+    if (found != m_jobs.end()) {
+        (*found)->ids.push_back(id);
+        return;
+    }
+
+    std::unique_ptr<Job> job(new Job());
+    job->filename = filename;
+    job->ids.push_back(id);
+    m_jobs.push_back(std::move(job));
+}
+
+/**
+ * Start decoding on worker threads.
+ * @param unsigned int thread_count
+ * Number of workers, 0 to use one per hardware thread. Never more workers
+ * than files.
+ */
+void TextureLoader::launch(unsigned int thread_count)
+{
+    if (thread_count == 0)
+        thread_count = std::max(1u, std::thread::hardware_concurrency());
+    for (std::unique_ptr<Job>& job : m_jobs)
+        m_decoding.add_task([this, &job = *job] { decode(job); });
+    m_decoding.execute(thread_count);
+}
+
+/**
+ * Upload decoded images into the holder.
+ * @param std::size_t max_uploads
+ * Upload at most this many files, to spread uploads over several frames.
+ * @return Number of files uploaded.
+ * @throw std::runtime_error if a file could not be decoded.
+ * @note Must be called from the thread that renders (OpenGL context).
+ */
+std::size_t TextureLoader::upload(std::size_t max_uploads)
+{
+    TraceScope scope("TextureLoader::upload");
+    std::size_t uploads = 0;
+    for (std::unique_ptr<Job>& job : m_jobs) {
+        if (uploads == max_uploads)
+            break;
+        if (job->is_uploaded || !job->is_decoded)
+            continue;
+        if (!job->is_loaded)
+            throw std::runtime_error("TextureLoader::upload - Failed to load "
+                    + job->filename);
+
+        m_textures.load(job->ids.front(), job->filename, job->image);
+        for (std::size_t i = 1; i < job->ids.size(); ++i)
+            m_textures.load_cached(job->ids[i], job->filename);
+
+        // pixels are on the GPU now
+        job->image = sf::Image();
+        job->is_uploaded = true;
+        ++m_uploaded_count;
+        ++uploads;
+    }
+    return uploads;
+}
+
+/**
+ * Block until every file is decoded and uploaded, uploading as they come.
+ */
+void TextureLoader::wait()
+{
+    while (!is_finished()) {
+        upload();
+        std::unique_lock<std::mutex> lock(m_decoded_mutex);
+        m_decoded_cond.wait(lock, [this] {
+            return m_decoded_count > m_uploaded_count
+                || m_decoded_count == m_jobs.size();
+        });
+    }
+}
+
+/**
+ * @return True once every queued file is in the holder.
+ */
+bool TextureLoader::is_finished() const
+{
+    return m_uploaded_count == m_jobs.size();
+}
+
+/**
+ * @return Progress from 0 to 1, decoding and uploading count for half each.
+ */
+float TextureLoader::get_completion() const
+{
+    if (m_jobs.empty())
+        return 1.f;
+    return static_cast<float>(m_decoded_count + m_uploaded_count)
+        / static_cast<float>(2 * m_jobs.size());
+}
+
+/**
+ * Decoding task, runs on a worker thread.
+ * @note Never throws: a failed file is still counted as decoded (not
+ * loaded), so wait() returns and upload() reports it.
+ */
+void TextureLoader::decode(Job& job)
+{
+    try {
+        Trace::set_thread_name("TextureLoader");
+        TraceScope scope("TextureLoader::decode");
+        job.is_loaded = job.image.loadFromFile(job.filename);
+    } catch (...) {
+        job.is_loaded = false;
+    }
+    job.is_decoded = true;
+    {
+        std::lock_guard<std::mutex> lock(m_decoded_mutex);
+        ++m_decoded_count;
+    }
+    m_decoded_cond.notify_one();
+}
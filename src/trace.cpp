@@ -0,0 +1,172 @@
+#include "trace.h"
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+    /**
+     * @struct Slot
+     * One span of the ring. Written by any thread, read by dump(): the
+     * sequence is odd while the span is written, so dump() skips spans that
+     * are half written (fields are atomic, nothing is ever torn).
+     */
+    struct Slot {
+        std::atomic<std::size_t> sequence{0};
+        std::atomic<const char*> name{nullptr};
+        std::atomic<std::int64_t> begin{0};
+        std::atomic<std::int64_t> duration{0};
+        std::atomic<std::uint32_t> thread{0};
+    };
+
+    const Trace::Clock::time_point START = Trace::Clock::now();
+
+    std::unique_ptr<Slot[]> slots(new Slot[Trace::CAPACITY]);
+    std::atomic<std::size_t> next_slot(0);
+    std::atomic<bool> is_enabled(true);
+
+    std::atomic<std::uint32_t> next_thread(1);
+    std::mutex thread_names_mutex;
+    std::map<std::uint32_t, std::string> thread_names;
+
+    /// Small id of the calling thread, the order threads first traced.
+    std::uint32_t get_thread_id()
+    {
+        thread_local std::uint32_t id = next_thread.fetch_add(1);
+        return id;
+    }
+
+    std::int64_t to_microseconds(Trace::Clock::duration duration)
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+                duration).count();
+    }
+
+    void write_string(std::ostream& out, const char* text)
+    {
+        out << '"';
+        for (const char* c = text; *c; ++c) {
+            if (*c == '"' || *c == '\\')
+                out << '\\';
+            out << *c;
+        }
+        out << '"';
+    }
+}
+
+/**
+ * Record a span of the calling thread. Lock-free, safe from any thread.
+ * @param const char* name
+ * Static string, only the pointer is kept.
+ */
+void Trace::record(const char* name, Clock::time_point begin,
+        Clock::time_point end)
+{
+    if (!is_enabled.load(std::memory_order_relaxed))
+        return;
+    std::size_t index = next_slot.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = slots[index % CAPACITY];
+
+    slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.begin.store(to_microseconds(begin - START),
+            std::memory_order_relaxed);
+    slot.duration.store(to_microseconds(end - begin),
+            std::memory_order_relaxed);
+    slot.thread.store(get_thread_id(), std::memory_order_relaxed);
+    slot.sequence.store(2 * index + 2, std::memory_order_release);
+}
+
+/**
+ * Name the calling thread's timeline (e.g., "Main", "SpeechToText").
+ */
+void Trace::set_thread_name(const char* name)
+{
+    std::uint32_t id = get_thread_id();
+    std::lock_guard<std::mutex> lock(thread_names_mutex);
+    thread_names[id] = name;
+}
+
+void Trace::set_enabled(bool enabled)
+{
+    is_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+/**
+ * Copy the spans in the ring and the thread names. Recording goes on
+ * meanwhile, spans written during the copy may be left out.
+ * @note Copies CAPACITY spans at most, no formatting or I/O.
+ */
+Trace::Snapshot Trace::snapshot()
+{
+    Snapshot snapshot;
+    {
+        std::lock_guard<std::mutex> lock(thread_names_mutex);
+        snapshot.thread_names.assign(thread_names.begin(),
+                thread_names.end());
+    }
+
+    snapshot.spans.reserve(CAPACITY);
+    for (std::size_t i = 0; i < CAPACITY; ++i) {
+        const Slot& slot = slots[i];
+        std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence == 0 || sequence % 2 == 1)
+            continue;
+        Span span;
+        span.name = slot.name.load(std::memory_order_relaxed);
+        span.begin = slot.begin.load(std::memory_order_relaxed);
+        span.duration = slot.duration.load(std::memory_order_relaxed);
+        span.thread = slot.thread.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != sequence)
+            continue;
+        snapshot.spans.push_back(span);
+    }
+    return snapshot;
+}
+
+/**
+ * Write a snapshot as Chrome trace-event JSON, from any thread.
+ * @return False if the file can't be written.
+ */
+bool Trace::write(const Snapshot& snapshot, const std::string& filename)
+{
+    std::ofstream out(filename);
+    if (!out)
+        return false;
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool is_first = true;
+    for (const auto& [id, name] : snapshot.thread_names) {
+        out << (is_first ? "" : ",\n")
+            << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":"
+            << id << ",\"args\":{\"name\":";
+        write_string(out, name.c_str());
+        out << "}}";
+        is_first = false;
+    }
+
+    for (const Span& span : snapshot.spans) {
+        out << (is_first ? "" : ",\n") << "{\"ph\":\"X\",\"name\":";
+        write_string(out, span.name);
+        out << ",\"pid\":1,\"tid\":" << span.thread << ",\"ts\":"
+            << span.begin << ",\"dur\":" << span.duration << "}";
+        is_first = false;
+    }
+    out << "\n]}\n";
+    return static_cast<bool>(out);
+}
+
+/**
+ * Snapshot and write on the calling thread.
+ * @return False if the file can't be written.
+ */
+bool Trace::dump(const std::string& filename)
+{
+    return write(snapshot(), filename);
+}
@@ -125,6 +125,15 @@ int random_int(int exclusive_max)
     return distr(RandomEngine);
 }
 
+/**
+ * Restart random_int() from seed, the same seed gives the same numbers (e.g.,
+ * replaying an input log).
+ */
+void seed_random(unsigned long seed)
+{
+    RandomEngine.seed(seed);
+}
+
 /// Returns float length of a float Vector2.
 float length(sf::Vector2f vec2)
 {
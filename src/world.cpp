@@ -3,10 +3,13 @@
 #include "projectile.h"
 #include "pickup.h"
 #include "text_node.h"
+#include "sprite_batch_node.h"
 #include "utility.h"
+#include "log.h"
+#include "profiler.h"
 
 #include <SFML/System/Vector2.hpp>
-#include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/RectangleShape.hpp>
 
 #include <algorithm>
@@ -17,17 +20,29 @@
 #include <limits>
 #include <map>
 
+/// Written by Player's movers, defined with the World so the simulation
+/// links without Player (e.g., world-bench).
+sf::Vector2f PREV_PLAYER_MOVEMENT(0.f, 0.f);
+
 namespace {
     static const sf::Vector2f SPAWN_POINT(900.f, 1100.f);
+    /// Collision grid cell size (px), around the size of a building.
+    static const float COLLISION_CELL_SIZE = 512.f;
 }
 
-World::World(sf::RenderWindow& window, FontHolder& fonts) :
+/**
+ * @param sf::RenderTarget* target
+ * Where draw() draws, nullptr to only simulate (no window needed, textures
+ * still need an OpenGL context).
+ */
+World::World(sf::RenderTarget* target, TextureHolder& textures,
+        FontHolder& fonts) :
     // initialize all parts of the world correctly
-    // window first ->
-    m_window(window),
+    // render target first ->
+    m_target(target),
 
     // systems second ->
-    m_textures(),
+    m_textures(textures),
     m_fonts(fonts),
     m_scene_graph(),
     m_scene_layers(),
@@ -53,7 +68,10 @@ World::World(sf::RenderWindow& window, FontHolder& fonts) :
      * m_npc_spawn_points(),
      * m_active_npcs() */
 
-    _map_asset_spawn_points()
+    _map_asset_spawn_points(),
+    m_collision_grid(m_world_bounds, COLLISION_CELL_SIZE),
+    m_static_colliders(),
+    m_collision_pairs()
 {
         load_textures();
         build_scene();
@@ -64,6 +82,7 @@ World::World(sf::RenderWindow& window, FontHolder& fonts) :
 
 void World::update(sf::Time delta_time)
 {
+    TraceScope scope("World::update");
     m_world_view.move(0.f, m_scroll_speed * delta_time.asSeconds());
     m_player_creature->set_velocity(0.f, 0.f);
 
@@ -73,13 +92,19 @@ void World::update(sf::Time delta_time)
 
     /** @brief Forward commands to the scene graph and adapt player velocity
      * correctly. */
-    while (!m_command_queue.is_empty())
-        m_scene_graph.on_command(m_command_queue.pop(), delta_time);
-    adapt_player_velocity();
+    {
+        ProfileProbe probe(Profiler::Commands);
+        while (!m_command_queue.is_empty())
+            m_scene_graph.on_command(m_command_queue.pop(), delta_time);
+        adapt_player_velocity();
+    }
 
     /// Constantly update collision detection and response (WARNING: May destroy
     /// Entity(ies).
-    handle_collisions();
+    {
+        ProfileProbe probe(Profiler::Collisions);
+        handle_collisions();
+    }
 
     // Handle Map collisions. If Player crosses a black border (how Map is
     // designed), revert the previous movement command.
@@ -88,26 +113,37 @@ void World::update(sf::Time delta_time)
     /** @remark UNUSED, no NPCs... */
     /// Remove all destroyed entities and create new ones.
     //m_scene_graph.removal();
-    handle_player_death();
-    //spawn_npcs();
-    spawn_map_assets();
+    {
+        ProfileProbe probe(Profiler::Spawns);
+        handle_player_death();
+        //spawn_npcs();
+        spawn_map_assets();
+    }
 
     /// Regular game update step, adapt player position (correct even though
     /// outside view, because adapt_player_position() handles appropriately).
-    m_scene_graph.update(delta_time, m_command_queue);
-    adapt_player_position();
-    handle_map_edges();
+    {
+        ProfileProbe probe(Profiler::SceneUpdate);
+        m_scene_graph.update(delta_time, m_command_queue);
+    }
+    {
+        ProfileProbe probe(Profiler::AdaptView);
+        adapt_player_position();
+        handle_map_edges();
+    }
 
-    // uncomment to print player position
+    // build with -DLOG_LEVEL=0 to print player position
     sf::Vector2f pos = m_player_creature->getPosition();
-    std::cout << std::setprecision(0) << std::fixed << "Player position: ("
-        << pos.x << ", " << pos.y << ")\n";
+    Log::trace("Player position: ({}, {})", pos.x, pos.y);
 }
 
 void World::draw()
 {
-    m_window.setView(m_world_view);
-    m_window.draw(m_scene_graph);
+    if (!m_target)
+        return;
+    m_target->setView(m_world_view);
+    /// Only draw the subtrees that intersect the view.
+    m_scene_graph.draw_culled(*m_target, get_view_bounds());
 }
 
 /**
@@ -121,11 +157,24 @@ CommandQueue& World::get_command_queue()
 
 /**
  * Loads textures for the World.
- * @remark Main fn that loads textures ... texture loading goes HERE.
+ * @remark Textures already loaded (e.g., by LoadingState) are skipped.
  */
 void World::load_textures()
 {
-    m_textures.load(Textures::Player, "textures/player/new-pete.png");
+    TextureLoader loader(m_textures);
+    queue_textures(loader);
+    loader.launch();
+    loader.wait();
+}
+
+/**
+ * Queue every texture the World uses.
+ * @remark Main fn that loads textures ... texture loading goes HERE.
+ * Files are decoded in parallel by TextureLoader, queue them here.
+ */
+void World::queue_textures(TextureLoader& loader)
+{
+    loader.queue(Textures::Player, "textures/player/new-pete.png");
     //m_textures.load(Textures::FireProjectile, "textures/player/player.png");
 
     //m_textures.load(Textures::Bunny, "textures/player/player.png");
@@ -140,37 +189,38 @@ void World::load_textures()
     //_map = m_textures.get(Textures::Map).copyToImage();
     //
 
-    load_map();
+    load_map(loader);
 }
 
-void World::load_map()
+void World::load_map(TextureLoader& loader)
 {
     std::string world = "textures/world/";
 
-    m_textures.load(Textures::Grass, world + "new-grass.png");
-
-    m_textures.load(Textures::StudentUnion, world + "student-union.png");
-    m_textures.load(Textures::CollegeCenter, world + "college-center.png");
-    m_textures.load(Textures::CampusSafety, world + "campus-safety.png");
-    m_textures.load(Textures::Classroom, world + "classroom.png");
-    m_textures.load(Textures::ClassroomFlipped, world + "classroom-flipped.png");
-    m_textures.load(Textures::Pool, world + "pool.png");
-    m_textures.load(Textures::RelayPool, world + "relay-pool.png");
-    m_textures.load(Textures::Football, world + "football.png");
-    m_textures.load(Textures::Soccer, world + "soccer.png");
-    m_textures.load(Textures::Tennis, world + "tennis.png");
-    m_textures.load(Textures::Harbor, world + "harbor.png");
-    m_textures.load(Textures::Mbcc, world + "mbcc.png");
-    m_textures.load(Textures::Maintenance, world + "maintenance.png");
-    m_textures.load(Textures::Starbucks, world + "starbucks.png");
-    m_textures.load(Textures::Track, world + "track.png");
-    m_textures.load(Textures::Baseball, world + "baseball.png");
-    m_textures.load(Textures::Library, world + "college-center.png");
-    m_textures.load(Textures::LewisCenter, world + "student-union.png");
-
-    m_textures.load(Textures::Scenery, world + "grass-assets-transparent.png");
-    m_textures.load(Textures::Scenery1, world + "grass-assets-transparent.png");
-    m_textures.load(Textures::Scenery2, world + "grass-assets-transparent.png");
+    loader.queue(Textures::Grass, world + "new-grass.png");
+
+    loader.queue(Textures::StudentUnion, world + "student-union.png");
+    loader.queue(Textures::CollegeCenter, world + "college-center.png");
+    loader.queue(Textures::CampusSafety, world + "campus-safety.png");
+    loader.queue(Textures::Classroom, world + "classroom.png");
+    loader.queue(Textures::ClassroomFlipped, world + "classroom-flipped.png");
+    loader.queue(Textures::Pool, world + "pool.png");
+    loader.queue(Textures::RelayPool, world + "relay-pool.png");
+    loader.queue(Textures::Football, world + "football.png");
+    loader.queue(Textures::Soccer, world + "soccer.png");
+    loader.queue(Textures::Tennis, world + "tennis.png");
+    loader.queue(Textures::Harbor, world + "harbor.png");
+    loader.queue(Textures::Mbcc, world + "mbcc.png");
+    loader.queue(Textures::Maintenance, world + "maintenance.png");
+    loader.queue(Textures::Starbucks, world + "starbucks.png");
+    loader.queue(Textures::Track, world + "track.png");
+    loader.queue(Textures::Baseball, world + "baseball.png");
+    loader.queue(Textures::Library, world + "college-center.png");
+    loader.queue(Textures::LewisCenter, world + "student-union.png");
+
+    /// Same files under several IDs are decoded and uploaded once.
+    loader.queue(Textures::Scenery, world + "grass-assets-transparent.png");
+    loader.queue(Textures::Scenery1, world + "grass-assets-transparent.png");
+    loader.queue(Textures::Scenery2, world + "grass-assets-transparent.png");
 }
 
 void World::build_scene()
@@ -210,10 +260,17 @@ void World::build_scene()
     /** No NPCs... */
     //add_npcs();
 
+    /// Spawn map assets now, so the static colliders are indexed once at
+    /// world build instead of on the first update.
     add_map_assets();
-
+    spawn_map_assets();
 }
 
+/**
+ * Builds the scenery props, batched into one SpriteBatchNode.
+ * @note Props never move, so they are merged into one vertex array per
+ * texture - one draw call per atlas instead of one per prop.
+ */
 void World::build_scenery()
 {
     // sf::IntRect(top, left, width, height)
@@ -242,387 +299,88 @@ void World::build_scenery()
         {"small_rock", {2000, 5000, 999, 892}}
     };
 
-    // Sprites for Textures::Scenery (first load):
-    sf::Texture& texture = m_textures.get(Textures::Scenery);
-
-    std::unique_ptr<SpriteNode> square_circle_trees(new SpriteNode(
-                texture, atlas.find("square_circle_trees")->second));
-    square_circle_trees->center_origin();
-    square_circle_trees->setPosition(1409.f, 672.f);
-    square_circle_trees->scale(0.5f, 0.5f);
-    m_scene_layers[Background]->attach_child(std::move(square_circle_trees));
-
-    std::unique_ptr<SpriteNode> medium_rock(new SpriteNode(
-                texture, atlas.find("medium_rock")->second));
-    medium_rock->center_origin();
-    medium_rock->setPosition(6049.f, 120.f);
-    medium_rock->scale(0.5f, 0.5f);
-    m_scene_layers[Background]->attach_child(std::move(medium_rock));
-
-    std::unique_ptr<SpriteNode> small_rock(new SpriteNode(
-                texture, atlas.find("small_rock")->second));
-    small_rock->center_origin();
-    small_rock->setPosition(5420.f, 2261.f);
-    small_rock->scale(0.5f, 0.5f);
-    m_scene_layers[Background]->attach_child(std::move(small_rock));
-
-    std::unique_ptr<SpriteNode> right_hedge(new SpriteNode(
-                texture, atlas.find("right_hedge")->second));
-    right_hedge->center_origin();
-    right_hedge->setPosition(4589.f, 172.f);
-    right_hedge->scale(0.5f, 0.5f);
-    m_scene_layers[Background]->attach_child(std::move(right_hedge));
-
-    std::unique_ptr<SpriteNode> big_rock(new SpriteNode(
-                texture, atlas.find("big_rock")->second));
-    big_rock->center_origin();
-    big_rock->setPosition(1611.f, 106.f);
-    big_rock->scale(0.5f, 0.5f);
-    m_scene_layers[Background]->attach_child(std::move(big_rock));
-
-    std::unique_ptr<SpriteNode> light_post(new SpriteNode(
-                texture, atlas.find("light_post")->second));
-    light_post->center_origin();
-    light_post->setPosition(217.f, 2940.f);
-    light_post->scale(0.5f, 0.5f);
-    m_scene_layers[Background]->attach_child(std::move(light_post));
-
-    std::unique_ptr<SpriteNode> big_fountain(new SpriteNode(
-                texture, atlas.find("big_fountain")->second));
-    big_fountain->center_origin();
-    big_fountain->setPosition(3261.f, 1369.f);
-    big_fountain->scale(0.5f, 0.5f);
-    m_scene_layers[Background]->attach_child(std::move(big_fountain));
-
-    std::unique_ptr<SpriteNode> circle_tree(new SpriteNode(
-                texture, atlas.find("circle_tree")->second));
-    circle_tree->center_origin();
-    circle_tree->setPosition(2414.f, 2535.f);
-    circle_tree->scale(0.5f, 0.5f);
-    m_scene_layers[Background]->attach_child(std::move(circle_tree));
-
-    std::unique_ptr<SpriteNode> benches(new SpriteNode(
-                texture, atlas.find("benches")->second));
-    benches->center_origin();
-    benches->setPosition(1870.f, 3036.f);
-    benches->scale(0.5f, 0.5f);
-    m_scene_layers[Background]->attach_child(std::move(benches));
-
-    std::unique_ptr<SpriteNode> nice_bench(new SpriteNode(
-                texture, atlas.find("nice_bench")->second));
-    nice_bench->center_origin();
-    nice_bench->setPosition(1078.f, 2612.f);
-    nice_bench->scale(0.5f, 0.5f);
-    m_scene_layers[Background]->attach_child(std::move(nice_bench));
-
-    std::unique_ptr<SpriteNode> square_triangle_trees(new SpriteNode(
-                texture, atlas.find("square_triangle_trees")->second));
-    square_triangle_trees->center_origin();
-    square_triangle_trees->setPosition(1166.f, 1611.f);
-    square_triangle_trees->scale(0.5f, 0.5f);
-    m_scene_layers[Background]->attach_child(std::move(square_triangle_trees));
-
-    std::unique_ptr<SpriteNode> bench(new SpriteNode(
-                texture, atlas.find("bench")->second));
-    bench->center_origin();
-    bench->setPosition(1765.f, 1727.f);
-    bench->scale(0.5f, 0.5f);
-    m_scene_layers[Background]->attach_child(std::move(bench));
-
-    std::unique_ptr<SpriteNode> left_hedge(new SpriteNode(
-                texture, atlas.find("left_hedge")->second));
-    left_hedge->center_origin();
-    left_hedge->setPosition(4603.f, 1380.f);
-    left_hedge->scale(0.5f, 0.5f);
-    m_scene_layers[Background]->attach_child(std::move(left_hedge));
-
-    std::unique_ptr<SpriteNode> bushes(new SpriteNode(
-                texture, atlas.find("bushes")->second));
-    bushes->center_origin();
-    bushes->setPosition(5241.f, 302.f);
-    bushes->scale(0.5f, 0.5f);
-    m_scene_layers[Background]->attach_child(std::move(bushes));
-
-    std::unique_ptr<SpriteNode> bush(new SpriteNode(
-                texture, atlas.find("bushes")->second));
-    bush->center_origin();
-    bush->setPosition(2319.f, 156.f);
-    bush->scale(0.5f, 0.5f);
-    m_scene_layers[Background]->attach_child(std::move(bush));
-
-    std::unique_ptr<SpriteNode> triangle_tree(new SpriteNode(
-                texture, atlas.find("triangle_tree")->second));
-    triangle_tree->center_origin();
-    triangle_tree->setPosition(150.f, 1013.f);
-    triangle_tree->scale(0.5f, 0.5f);
-    m_scene_layers[Background]->attach_child(std::move(triangle_tree));
-
-    std::unique_ptr<SpriteNode> bridge(new SpriteNode(
-                texture, atlas.find("bridge")->second));
-    bridge->center_origin();
-    bridge->setPosition(777.f, 1103.f);
-    bridge->scale(0.5f, 0.5f);
-    m_scene_layers[Background]->attach_child(std::move(bridge));
-
-    std::unique_ptr<SpriteNode> small_fountain(new SpriteNode(
-                texture, atlas.find("small_fountain")->second));
-    small_fountain->center_origin();
-    small_fountain->setPosition(6072.f, 1457.f);
-    small_fountain->scale(0.5f, 0.5f);
-    m_scene_layers[Background]->attach_child(std::move(small_fountain));
-
-    // Sprites for Textures::Scenery1 (second load):
-    sf::Texture& texture1 = m_textures.get(Textures::Scenery1);
-
-    std::unique_ptr<SpriteNode> big_fountain1(new SpriteNode(
-                texture1, atlas.find("big_fountain")->second));
-    big_fountain1->center_origin();
-    big_fountain1->setPosition(3586.f, 3234.f);
-    big_fountain1->scale(0.5f, 0.5f);
-    m_scene_layers[Background]->attach_child(std::move(big_fountain1));
-
-    std::unique_ptr<SpriteNode> benches1(new SpriteNode(
-                texture1, atlas.find("benches")->second));
-    benches1->center_origin();
-    benches1->setPosition(4196.f, 2183.f);
-    benches1->scale(0.5f, 0.5f);
-    m_scene_layers[Background]->attach_child(std::move(benches1));
-
-    std::unique_ptr<SpriteNode> square_triangle_trees1(new SpriteNode(
-                texture1, atlas.find("square_triangle_trees")->second));
-    square_triangle_trees1->center_origin();
-    square_triangle_trees1->setPosition(5042.f, 1151.f);
-    square_triangle_trees1->scale(0.5f, 0.5f);
-    m_scene_layers[Background]->attach_child(std::move(square_triangle_trees1));
-
-    std::unique_ptr<SpriteNode> bridge1(new SpriteNode(
-                texture1, atlas.find("bridge")->second));
-    bridge1->center_origin();
-    bridge1->setPosition(1250.f, 970.f);
-    bridge1->scale(0.5f, 0.5f);
-    m_scene_layers[Background]->attach_child(std::move(bridge1));
-
-    std::unique_ptr<SpriteNode> circle_tree1(new SpriteNode(
-                texture1, atlas.find("circle_tree")->second));
-    circle_tree1->center_origin();
-    circle_tree1->setPosition(1595.f, 803.f);
-    circle_tree1->scale(0.5f, 0.5f);
-    m_scene_layers[Background]->attach_child(std::move(circle_tree1));
-
-    std::unique_ptr<SpriteNode> nice_bench1(new SpriteNode(
-                texture1, atlas.find("nice_bench")->second));
-    nice_bench1->center_origin();
-    nice_bench1->setPosition(1096.f, 331.f);
-    nice_bench1->scale(0.5f, 0.5f);
-    m_scene_layers[Background]->attach_child(std::move(nice_bench1));
-
-    std::unique_ptr<SpriteNode> left_hedge1(new SpriteNode(
-                texture1, atlas.find("left_hedge")->second));
-    left_hedge1->center_origin();
-    left_hedge1->setPosition(2338.f, 901.f);
-    left_hedge1->scale(0.5f, 0.5f);
-    m_scene_layers[Background]->attach_child(std::move(left_hedge1));
-
-    std::unique_ptr<SpriteNode> light_post1(new SpriteNode(
-                texture1, atlas.find("light_post")->second));
-    light_post1->center_origin();
-    light_post1->setPosition(1645.f, 3296.f);
-    light_post1->scale(0.5f, 0.5f);
-    m_scene_layers[Background]->attach_child(std::move(light_post1));
-
-    std::unique_ptr<SpriteNode> big_rock1(new SpriteNode(
-                texture1, atlas.find("big_rock")->second));
-    big_rock1->center_origin();
-    big_rock1->setPosition(1372.f, 1968.f);
-    big_rock1->scale(0.5f, 0.5f);
-    m_scene_layers[Background]->attach_child(std::move(big_rock1));
-
-    std::unique_ptr<SpriteNode> right_hedge1(new SpriteNode(
-                texture1, atlas.find("right_hedge")->second));
-    right_hedge1->center_origin();
-    right_hedge1->setPosition(2668.f, 235.f);
-    right_hedge1->scale(0.5f, 0.5f);
-    m_scene_layers[Background]->attach_child(std::move(right_hedge1));
-
-    std::unique_ptr<SpriteNode> small_fountain1(new SpriteNode(
-                texture1, atlas.find("small_fountain")->second));
-    small_fountain1->center_origin();
-    small_fountain1->setPosition(4162.f, 1171.f);
-    small_fountain1->scale(0.5f, 0.5f);
-    m_scene_layers[Background]->attach_child(std::move(small_fountain1));
-
-    std::unique_ptr<SpriteNode> medium_rock1(new SpriteNode(
-                texture1, atlas.find("medium_rock")->second));
-    medium_rock1->center_origin();
-    medium_rock1->setPosition(6855.f, 2062.f);
-    medium_rock1->scale(0.5f, 0.5f);
-    m_scene_layers[Background]->attach_child(std::move(medium_rock1));
-
-    std::unique_ptr<SpriteNode> small_rock1(new SpriteNode(
-                texture1, atlas.find("small_rock")->second));
-    small_rock1->center_origin();
-    small_rock1->setPosition(6133.f, 1772.f);
-    small_rock1->scale(0.5f, 0.5f);
-    m_scene_layers[Background]->attach_child(std::move(small_rock1));
-
-    std::unique_ptr<SpriteNode> bushes1(new SpriteNode(
-                texture, atlas.find("bushes")->second));
-    bushes1->center_origin();
-    bushes1->setPosition(3895.f, 364.f);
-    bushes1->scale(0.5f, 0.5f);
-    m_scene_layers[Background]->attach_child(std::move(bushes1));
-
-    // xxx set pos
-    //std::unique_ptr<SpriteNode> bush(new SpriteNode(
-    //            texture, atlas.find("bushes")->second));
-    //bush->center_origin();
-    //bush->setPosition(5241.f, 302.f);
-    //bush->scale(0.5f, 0.5f);
-    //m_scene_layers[Background]->attach_child(std::move(bush));
-
-    //std::unique_ptr<SpriteNode> bench4(new SpriteNode(
-    //            texture1, atlas.find("benches")->second));
-    //bench4->setPosition(5456.f, 2788.f);
-    //bench4->scale(0.5f, 0.5f);
-    //m_scene_layers[Background]->attach_child(std::move(bench4));
-
-    // Sprites for Textures::Scenery2 (third load):
-    sf::Texture& texture2 = m_textures.get(Textures::Scenery2);
-
-    // pos already set!
-    std::unique_ptr<SpriteNode> square_circle_trees2(new SpriteNode(
-                texture2, atlas.find("square_circle_trees")->second));
-    square_circle_trees2->center_origin();
-    square_circle_trees2->setPosition(5861.f, 1539.f);
-    square_circle_trees2->scale(0.5f, 0.5f);
-    m_scene_layers[Background]->attach_child(std::move(square_circle_trees2));
-
-    // pos set now
-    std::unique_ptr<SpriteNode> square_triangle_trees2(new SpriteNode(
-                texture2, atlas.find("square_triangle_trees")->second));
-    square_triangle_trees2->center_origin();
-    square_triangle_trees2->setPosition(5743.f, 1872.f);
-    square_triangle_trees2->scale(0.5f, 0.5f);
-    m_scene_layers[Background]->attach_child(std::move(square_triangle_trees2));
-
-    // pos set now
-    std::unique_ptr<SpriteNode> triangle_tree2(new SpriteNode(
-                texture2, atlas.find("triangle_tree")->second));
-    triangle_tree2->center_origin();
-    triangle_tree2->setPosition(3553.f, 697.f);
-    triangle_tree2->scale(0.5f, 0.5f);
-    m_scene_layers[Background]->attach_child(std::move(triangle_tree2));
-
-    // pos already set!
-    std::unique_ptr<SpriteNode> big_fountain2(new SpriteNode(
-                texture2, atlas.find("big_fountain")->second));
-    big_fountain2->center_origin();
-    big_fountain2->setPosition(5605.f, 2621.f);
-    big_fountain2->scale(0.5f, 0.5f);
-    m_scene_layers[Background]->attach_child(std::move(big_fountain2));
-
-    // pos set now
-    std::unique_ptr<SpriteNode> left_hedge2(new SpriteNode(
-                texture2, atlas.find("left_hedge")->second));
-    left_hedge2->center_origin();
-    left_hedge2->setPosition(6846.f, 1357.f);
-    left_hedge2->scale(0.5f, 0.5f);
-    m_scene_layers[Background]->attach_child(std::move(left_hedge2));
-
-    // pos set now
-    std::unique_ptr<SpriteNode> circle_tree2(new SpriteNode(
-                texture2, atlas.find("circle_tree")->second));
-    circle_tree2->center_origin();
-    circle_tree2->setPosition(5948.f, 762.f);
-    circle_tree2->scale(0.5f, 0.5f);
-    m_scene_layers[Background]->attach_child(std::move(circle_tree2));
-
-    // pos already set!
-    std::unique_ptr<SpriteNode> light_post2(new SpriteNode(
-                texture2, atlas.find("light_post")->second));
-    light_post2->center_origin();
-    light_post2->setPosition(999.f, 3181.f);
-    light_post2->scale(0.5f, 0.5f);
-    m_scene_layers[Background]->attach_child(std::move(light_post2));
-
-    // pos set now
-    std::unique_ptr<SpriteNode> big_rock2(new SpriteNode(
-                texture2, atlas.find("big_rock")->second));
-    big_rock2->center_origin();
-    big_rock2->setPosition(6733.f, 316.f);
-    big_rock2->scale(0.5f, 0.5f);
-    m_scene_layers[Background]->attach_child(std::move(big_rock2));
-
-    std::unique_ptr<SpriteNode> right_hedge2(new SpriteNode(
-                texture2, atlas.find("right_hedge")->second));
-    right_hedge2->center_origin();
-    right_hedge2->setPosition(2668.f, 235.f);
-    right_hedge2->scale(0.5f, 0.5f);
-    m_scene_layers[Background]->attach_child(std::move(right_hedge2));
-
-    // pos set now
-    std::unique_ptr<SpriteNode> small_fountain2(new SpriteNode(
-                texture2, atlas.find("small_fountain")->second));
-    small_fountain2->center_origin();
-    small_fountain2->setPosition(6474.f, 3076.f);
-    small_fountain2->scale(0.5f, 0.5f);
-    m_scene_layers[Background]->attach_child(std::move(small_fountain2));
-
-    // pos set now
-    std::unique_ptr<SpriteNode> bushes2(new SpriteNode(
-                texture2, atlas.find("bushes")->second));
-    bushes2->center_origin();
-    bushes2->setPosition(6773.f, 2613.f);
-    bushes2->scale(0.5f, 0.5f);
-    m_scene_layers[Background]->attach_child(std::move(bushes2));
-
-    // pos set now
-    std::unique_ptr<SpriteNode> bush2(new SpriteNode(
-                texture2, atlas.find("bushes")->second));
-    bush2->center_origin();
-    bush2->setPosition(5240.f, 3833.f);
-    bush2->scale(0.5f, 0.5f);
-    m_scene_layers[Background]->attach_child(std::move(bush2));
-
-    // pos already set!
-    std::unique_ptr<SpriteNode> benches2(new SpriteNode(
-                texture2, atlas.find("benches")->second));
-    benches2->center_origin();
-    benches2->setPosition(5249.f, 3096.f);
-    benches2->scale(0.5f, 0.5f);
-    m_scene_layers[Background]->attach_child(std::move(benches2));
-
-    // pos set now
-    std::unique_ptr<SpriteNode> bench2(new SpriteNode(
-                texture2, atlas.find("bench")->second));
-    bench2->center_origin();
-    bench2->setPosition(6246.f, 3513.f);
-    bench2->scale(0.5f, 0.5f);
-    m_scene_layers[Background]->attach_child(std::move(bench2));
-
-    // pos set now
-    std::unique_ptr<SpriteNode> nice_bench2(new SpriteNode(
-                texture2, atlas.find("nice_bench")->second));
-    nice_bench2->center_origin();
-    nice_bench2->setPosition(4875.f, 3252.f);
-    nice_bench2->scale(0.5f, 0.5f);
-    m_scene_layers[Background]->attach_child(std::move(nice_bench2));
-
-    // pos set now
-    std::unique_ptr<SpriteNode> medium_rock2(new SpriteNode(
-                texture2, atlas.find("medium_rock")->second));
-    medium_rock2->center_origin();
-    medium_rock2->setPosition(4963.f, 4184.f);
-    medium_rock2->scale(0.5f, 0.5f);
-    m_scene_layers[Background]->attach_child(std::move(medium_rock2));
-
-    // pos set now
-    std::unique_ptr<SpriteNode> small_rock2(new SpriteNode(
-                texture2, atlas.find("small_rock")->second));
-    small_rock2->center_origin();
-    small_rock2->setPosition(5741.f, 4113.f);
-    small_rock2->scale(0.5f, 0.5f);
-    m_scene_layers[Background]->attach_child(std::move(small_rock2));
+    /**
+     * @struct Prop
+     * Scenery prop: texture, atlas entry, and (x, y) position.
+     */
+    struct Prop {
+        Textures::ID texture;
+        const char* name;
+        sf::Vector2f position;
+    };
+
+    const std::vector<Prop> props {
+        // Sprites for Textures::Scenery:
+        {Textures::Scenery, "square_circle_trees", {1409.f, 672.f}},
+        {Textures::Scenery, "medium_rock", {6049.f, 120.f}},
+        {Textures::Scenery, "small_rock", {5420.f, 2261.f}},
+        {Textures::Scenery, "right_hedge", {4589.f, 172.f}},
+        {Textures::Scenery, "big_rock", {1611.f, 106.f}},
+        {Textures::Scenery, "light_post", {217.f, 2940.f}},
+        {Textures::Scenery, "big_fountain", {3261.f, 1369.f}},
+        {Textures::Scenery, "circle_tree", {2414.f, 2535.f}},
+        {Textures::Scenery, "benches", {1870.f, 3036.f}},
+        {Textures::Scenery, "nice_bench", {1078.f, 2612.f}},
+        {Textures::Scenery, "square_triangle_trees", {1166.f, 1611.f}},
+        {Textures::Scenery, "bench", {1765.f, 1727.f}},
+        {Textures::Scenery, "left_hedge", {4603.f, 1380.f}},
+        {Textures::Scenery, "bushes", {5241.f, 302.f}},
+        {Textures::Scenery, "bushes", {2319.f, 156.f}},
+        {Textures::Scenery, "triangle_tree", {150.f, 1013.f}},
+        {Textures::Scenery, "bridge", {777.f, 1103.f}},
+        {Textures::Scenery, "small_fountain", {6072.f, 1457.f}},
+        {Textures::Scenery, "bushes", {3895.f, 364.f}},
+
+        // Sprites for Textures::Scenery1:
+        {Textures::Scenery1, "big_fountain", {3586.f, 3234.f}},
+        {Textures::Scenery1, "benches", {4196.f, 2183.f}},
+        {Textures::Scenery1, "square_triangle_trees", {5042.f, 1151.f}},
+        {Textures::Scenery1, "bridge", {1250.f, 970.f}},
+        {Textures::Scenery1, "circle_tree", {1595.f, 803.f}},
+        {Textures::Scenery1, "nice_bench", {1096.f, 331.f}},
+        {Textures::Scenery1, "left_hedge", {2338.f, 901.f}},
+        {Textures::Scenery1, "light_post", {1645.f, 3296.f}},
+        {Textures::Scenery1, "big_rock", {1372.f, 1968.f}},
+        {Textures::Scenery1, "right_hedge", {2668.f, 235.f}},
+        {Textures::Scenery1, "small_fountain", {4162.f, 1171.f}},
+        {Textures::Scenery1, "medium_rock", {6855.f, 2062.f}},
+        {Textures::Scenery1, "small_rock", {6133.f, 1772.f}},
+        // xxx set pos: bush {5241.f, 302.f}, benches {5456.f, 2788.f}
+
+        // Sprites for Textures::Scenery2:
+        {Textures::Scenery2, "square_circle_trees", {5861.f, 1539.f}},
+        {Textures::Scenery2, "square_triangle_trees", {5743.f, 1872.f}},
+        {Textures::Scenery2, "triangle_tree", {3553.f, 697.f}},
+        {Textures::Scenery2, "big_fountain", {5605.f, 2621.f}},
+        {Textures::Scenery2, "left_hedge", {6846.f, 1357.f}},
+        {Textures::Scenery2, "circle_tree", {5948.f, 762.f}},
+        {Textures::Scenery2, "light_post", {999.f, 3181.f}},
+        {Textures::Scenery2, "big_rock", {6733.f, 316.f}},
+        {Textures::Scenery2, "right_hedge", {2668.f, 235.f}},
+        {Textures::Scenery2, "small_fountain", {6474.f, 3076.f}},
+        {Textures::Scenery2, "bushes", {6773.f, 2613.f}},
+        {Textures::Scenery2, "bushes", {5240.f, 3833.f}},
+        {Textures::Scenery2, "benches", {5249.f, 3096.f}},
+        {Textures::Scenery2, "bench", {6246.f, 3513.f}},
+        {Textures::Scenery2, "nice_bench", {4875.f, 3252.f}},
+        {Textures::Scenery2, "medium_rock", {4963.f, 4184.f}},
+        {Textures::Scenery2, "small_rock", {5741.f, 4113.f}},
+    };
+
+    std::unique_ptr<SpriteBatchNode> scenery(new SpriteBatchNode());
+    for (const Prop& prop : props) {
+        const sf::IntRect& rect = atlas.find(prop.name)->second;
+        // same transform a SpriteNode got from center_origin(), setPosition()
+        // and scale(0.5f, 0.5f)
+        sf::Transformable transformable;
+        transformable.setOrigin(std::floor(rect.width / 2.f),
+                std::floor(rect.height / 2.f));
+        transformable.setPosition(prop.position);
+        transformable.setScale(0.5f, 0.5f);
+        scenery->add_sprite(m_textures.get(prop.texture), rect,
+                transformable.getTransform());
+    }
+    m_scene_layers[Background]->attach_child(std::move(scenery));
 }
 
 /**
@@ -775,9 +533,8 @@ void World::spawn_npcs()
             // set enemy pos to spawn pos
             npc->setPosition(spawn.vec2.x, spawn.vec2.y);
             // print success and pos for confirmation
-            std::cout << spawn.type << " spawned in the world!" << " ("
-                << std::setprecision(0) << spawn.vec2.x << ", " << spawn.vec2.y
-                << ")\n";
+            Log::info("Creature {} spawned in the world! ({}, {})",
+                    spawn.type, spawn.vec2.x, spawn.vec2.y);
 
             // bind to foreground layer
             m_scene_layers[Foreground]->attach_child(std::move(npc));
@@ -809,7 +566,7 @@ void World::add_npc(Creature::Type type, sf::Vector2f& vec2_rel)
     // after init spawn with enemy type and pos of spawn, push into spawn point
     // vec
     m_npc_spawn_points.push_back(spawn);
-    std::cout << spawn.type << " added to NPC spawn points" << std::endl;
+    Log::debug("Creature {} added to NPC spawn points", spawn.type);
 }
 
 /**
@@ -916,10 +673,18 @@ sf::FloatRect World::get_chunk_bounds() const
  */
 void World::handle_collisions()
 {
-    /// Initialize collision_pairs set for scene graph to use.
-    std::set<SceneNode::Pair> collision_pairs;
-    m_scene_graph.check_scene_collision(m_scene_graph, collision_pairs);
-    for (SceneNode::Pair pair : collision_pairs) {
+    /// Register moving collidable nodes in the grid and collect the pairs
+    /// that share a cell and intersect.
+    m_collision_grid.clear();
+    m_collision_pairs.clear();
+    m_scene_graph.register_colliders(m_collision_grid);
+    m_collision_grid.find_pairs(m_collision_pairs);
+    /// Then query only the moving nodes against the static colliders.
+    for (const CollisionGrid::Collider& collider :
+            m_collision_grid.get_colliders())
+        m_static_colliders.query(*collider.node, collider.rect,
+                m_collision_pairs);
+    for (SceneNode::Pair pair : m_collision_pairs) {
         /// For Player/Pickup, apply the pickup to the player and destroy the
         /// pickup.
         //if (matches_categories(pair, Category::Player, Category::PlayerPickup)) {
@@ -951,7 +716,7 @@ void World::handle_collisions()
         //    projectile.destroy();
         if (matches_categories(pair, Category::Player,
                                       Category::MapAsset)) {
-            std::cout << "Collision with MapAsset detected!\n";
+            Log::debug("Collision with MapAsset detected!");
 
             auto& player = static_cast<Creature&>(*pair.first);
             auto& map = static_cast<Creature&>(*pair.second);
@@ -1018,9 +783,9 @@ void World::handle_map_collisions()
             || color_at_xy == sf::Color(63, 0, 127)
             || color_at_xy == sf::Color(95, 62, 29)
             || color_at_xy == sf::Color(255, 106, 0)) {
-        std::cout << "Player hit wall of building!\n";
         sf::Vector2f prev = PREV_PLAYER_MOVEMENT;
-        std::cout << prev.x << "\n" << prev.y << "\n";
+        Log::debug("Player hit wall of building! Pushed back ({}, {})",
+                prev.x, prev.y);
         m_player_creature->accelerate(-prev);
 
         // damage player 0.05 hp (~1/24th of a day)
@@ -1090,6 +855,8 @@ void World::handle_player_death()
         // @note original unique_ptr will lose scope and call its destructor
         // - memory safe
         m_scene_graph.removal();
+        // removal() may have freed static nodes, index again
+        build_static_colliders();
         // Add player character to the scene.
         std::unique_ptr<Creature> player(new Creature(
                 Creature::Player, m_textures, m_fonts));
@@ -1110,7 +877,16 @@ void World::add_map_asset(Creature::Type type, sf::Vector2f& coord)
     // after init spawn with enemy type and pos of spawn, push into spawn point
     // vec
     _map_asset_spawn_points.push_back(spawn);
-    std::cout << spawn.type << " added to MapAsset spawn points" << std::endl;
+    Log::debug("Creature {} added to MapAsset spawn points", spawn.type);
+}
+
+/**
+ * Add a Creature to the world (e.g., generated scenes of world-bench), it
+ * spawns with the map assets on the next update().
+ */
+void World::add_creature(Creature::Type type, sf::Vector2f position)
+{
+    add_map_asset(type, position);
 }
 
 void World::add_map_assets()
@@ -1204,6 +980,10 @@ void World::add_map_assets()
 }
 
 void World::spawn_map_assets() {
+    /// Nothing new to index, don't rebuild static colliders every update.
+    if (_map_asset_spawn_points.empty())
+        return;
+
     while (!_map_asset_spawn_points.empty()) {
         SpawnPoint spawn = _map_asset_spawn_points.back();
         std::unique_ptr<Creature> map_asset(
@@ -1211,13 +991,26 @@ void World::spawn_map_assets() {
         map_asset->setPosition(spawn.vec2.x, spawn.vec2.y);
 
         // print success and pos for confirmation
-        std::cout << spawn.type << " spawned in the world!" << " ("
-            << std::setprecision(0) << spawn.vec2.x << ", " << spawn.vec2.y
-            << ")\n";
+        Log::info("Creature {} spawned in the world! ({}, {})", spawn.type,
+                spawn.vec2.x, spawn.vec2.y);
 
         m_scene_layers[Foreground]->attach_child(std::move(map_asset));
         _map_asset_spawn_points.pop_back();
     }
+
+    build_static_colliders();
+}
+
+/**
+ * Index every static node (buildings) in the scene graph once, their
+ * bounding rectangles are not recomputed per collision query.
+ * @note Called after spawn_map_assets() spawns, and after removal().
+ */
+void World::build_static_colliders()
+{
+    m_static_colliders.clear();
+    m_scene_graph.register_static_colliders(m_static_colliders);
+    m_static_colliders.build();
 }
 
 //void World::spawn_map_assets() {
@@ -0,0 +1,146 @@
+/** @file audio-source.h
+ * Where SpeechToText gets its audio: the microphone, a file, or a generated
+ * stream.
+ */
+
+#pragma once
+
+#include "stream-recorder.h"
+
+#include <SFML/Audio/InputSoundFile.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Time.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+namespace stt {
+
+/**
+ * @class AudioSource
+ * Yields blocks of mono 16-bit samples to SpeechToText::run(), which decodes
+ * them the same whatever the source.
+ * @note start(), read() and stop() are called from the run() thread.
+ */
+class AudioSource {
+public:
+    /**
+    * @enum Pace
+    * RealTime yields samples no faster than they would be captured, MaxSpeed
+    * as fast as they are read (e.g., to benchmark).
+    */
+    enum class Pace {
+        RealTime,
+        MaxSpeed,
+    };
+
+    virtual ~AudioSource() = default;
+
+    /** @return False if the source can't give audio at sample_rate. */
+    virtual bool start(unsigned int sample_rate) = 0;
+    virtual void stop() = 0;
+    /**
+     * Take the next samples, waits at most timeout for some.
+     * @return Number of samples read, 0 if there were none before timeout.
+     */
+    virtual std::size_t read(short* samples, std::size_t count,
+                             sf::Time timeout) = 0;
+    /** @return True once the source has nothing left (live never ends). */
+    virtual bool is_finished() const;
+    /** @return Samples lost because the reader did not keep up. */
+    virtual std::size_t get_dropped_count() const;
+};
+
+/**
+ * @class MicrophoneSource
+ * Live capture from the default input device, see StreamRecorder.
+ */
+class MicrophoneSource : public AudioSource {
+public:
+    MicrophoneSource();
+
+    bool start(unsigned int sample_rate) override;
+    void stop() override;
+    std::size_t read(short* samples, std::size_t count,
+                     sf::Time timeout) override;
+    std::size_t get_dropped_count() const override;
+private:
+    StreamRecorder _recorder;
+};
+
+/**
+ * @class FileSource
+ * Plays back a recording: WAV (or anything sf::InputSoundFile reads), or raw
+ * 16-bit little-endian samples (.raw, .pcm) taken to be at the sample rate.
+ * @remark Recordings must be mono at the sample rate, nothing is resampled.
+ */
+class FileSource : public AudioSource {
+public:
+    explicit FileSource(const std::string& filename, Pace pace = Pace::RealTime);
+
+    bool start(unsigned int sample_rate) override;
+    void stop() override;
+    std::size_t read(short* samples, std::size_t count,
+                     sf::Time timeout) override;
+    bool is_finished() const override;
+private:
+    std::size_t read_file(short* samples, std::size_t count);
+
+    std::string _filename;
+    Pace _pace;
+    bool _is_raw;
+    sf::InputSoundFile _file;
+    std::ifstream _raw;
+    unsigned int _sample_rate;
+    sf::Clock _clock;
+    std::size_t _played;
+    bool _is_finished;
+};
+
+/**
+ * @class SyntheticSource
+ * Generated stream: voice-like bursts (a gliding harmonic tone, which the
+ * voice activity detector takes for speech) between gaps of background noise.
+ * Decodes nothing meaningful, it exercises the whole voice path without a
+ * microphone or recordings (e.g., for load tests).
+ */
+class SyntheticSource : public AudioSource {
+public:
+    /**
+     * @struct Settings
+     * Shape of the stream, duration 0 for an endless one.
+     */
+    struct Settings {
+        sf::Time burst = sf::milliseconds(600);
+        sf::Time gap = sf::milliseconds(900);
+        sf::Time duration = sf::Time::Zero;
+        /// Peak amplitude of bursts and of the background noise.
+        short amplitude = 8000;
+        short noise = 60;
+        std::uint32_t seed = 1;
+    };
+
+    explicit SyntheticSource(const Settings& settings,
+                             Pace pace = Pace::RealTime);
+
+    bool start(unsigned int sample_rate) override;
+    void stop() override;
+    std::size_t read(short* samples, std::size_t count,
+                     sf::Time timeout) override;
+    bool is_finished() const override;
+private:
+    short next_sample();
+
+    Settings _settings;
+    Pace _pace;
+    unsigned int _sample_rate;
+    sf::Clock _clock;
+    std::size_t _played;
+    std::size_t _total;
+    double _phase;
+    std::uint32_t _noise_state;
+};
+
+}
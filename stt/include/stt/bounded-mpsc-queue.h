@@ -0,0 +1,135 @@
+/** @file bounded-mpsc-queue.h
+ * Lock-free multi-producer/single-consumer queue, bounded.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace stt {
+
+/**
+ * @class BoundedMpscQueue
+ * Fixed capacity queue of T, any thread pushes and one thread pops. Every
+ * cell carries a sequence number that says whose turn it is, so producers
+ * only race on the head index, and the consumer never waits. Neither side
+ * locks or allocates, the cells are allocated once.
+ * @remark Bounded: push() fails when the queue is full, what to do with the
+ * item (drop, count) is up to the caller.
+ * @warning Only one consumer thread.
+ */
+template <typename T>
+class BoundedMpscQueue {
+public:
+    explicit BoundedMpscQueue(std::size_t capacity);
+
+    bool push(const T& item);
+    bool pop(T& item);
+    std::size_t get_push_count() const;
+private:
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        T item;
+    };
+
+    // keep the indices on separate cache lines, no false sharing
+    static constexpr std::size_t CACHE_LINE = 64;
+
+    std::unique_ptr<Cell[]> _cells;
+    std::size_t _mask;
+    /// Next push, claimed by producers with compare-exchange.
+    alignas(CACHE_LINE) std::atomic<std::size_t> _head;
+    /// Next pop, consumer only.
+    alignas(CACHE_LINE) std::size_t _tail;
+};
+
+/**
+ * @param std::size_t capacity
+ * Rounded up to a power of 2, at least 2 (with one cell, the sequence of a
+ * full cell would read as free for the next lap).
+ */
+template <typename T>
+BoundedMpscQueue<T>::BoundedMpscQueue(std::size_t capacity) :
+    _cells(),
+    _mask(0),
+    _head(0),
+    _tail(0)
+{
+    std::size_t size = 2;
+    while (size < capacity)
+        size <<= 1;
+    _cells.reset(new Cell[size]);
+    _mask = size - 1;
+    // cell i is free for the push at position i
+    for (std::size_t i = 0; i < size; ++i)
+        _cells[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+/**
+ * Producer: copy item in. Safe from any thread.
+ * @return False if the queue is full (item is not pushed).
+ */
+template <typename T>
+bool BoundedMpscQueue<T>::push(const T& item)
+{
+    std::size_t pos = _head.load(std::memory_order_relaxed);
+    Cell* cell;
+    for (;;) {
+        cell = &_cells[pos & _mask];
+        std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        std::intptr_t diff = static_cast<std::intptr_t>(sequence)
+            - static_cast<std::intptr_t>(pos);
+        if (diff == 0) {
+            // cell is free, claim pos (pos is reloaded on failure)
+            if (_head.compare_exchange_weak(pos, pos + 1,
+                        std::memory_order_relaxed))
+                break;
+        } else if (diff < 0) {
+            // consumer has not freed the cell yet: full
+            return false;
+        } else {
+            // another producer claimed pos
+            pos = _head.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->item = item;
+    // publish to the consumer
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+/**
+ * Consumer: copy the oldest item out, never waits.
+ * @return False if the queue is empty (or its oldest item is still being
+ * written).
+ */
+template <typename T>
+bool BoundedMpscQueue<T>::pop(T& item)
+{
+    Cell& cell = _cells[_tail & _mask];
+    if (cell.sequence.load(std::memory_order_acquire) != _tail + 1)
+        return false;
+
+    item = cell.item;
+    // free the cell for the push one lap later
+    cell.sequence.store(_tail + _mask + 1, std::memory_order_release);
+    ++_tail;
+    return true;
+}
+
+/**
+ * @return Pushes claimed so far (failed ones not counted), a snapshot when
+ * called while producers push. Once the consumer popped that many items,
+ * everything pushed before the call was popped.
+ */
+template <typename T>
+std::size_t BoundedMpscQueue<T>::get_push_count() const
+{
+    return _head.load(std::memory_order_acquire);
+}
+
+}
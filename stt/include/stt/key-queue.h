@@ -0,0 +1,60 @@
+/** @file key-queue.h
+ * Keys recognized by SpeechToText, and the queue that hands them to the game.
+ */
+
+#pragma once
+
+#include "bounded-mpsc-queue.h"
+
+#include <chrono>
+#include <cstddef>
+
+namespace stt {
+
+/** @enum Key
+*  Interface to obtain key pressed from SpeechToText.
+*  @remark Size of enum is defined, to be forwarded.
+*/
+enum class Key {
+    None = -1,
+    A = 0,
+    Up,
+    Down,
+    Left,
+    Right,
+    Play,
+    Exit,
+};
+
+/**
+ * @class KeyQueue
+ * Bounded lock-free multi-producer/single-consumer queue of timestamped keys
+ * (a BoundedMpscQueue). Any thread may push (e.g., decoding threads), one
+ * thread pops (the game thread).
+ * @remark Bounded: push() drops the key when the queue is full, a full queue
+ * means nobody is consuming.
+ */
+class KeyQueue {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @struct Entry
+     * A key and when it was recognized.
+     */
+    struct Entry {
+        Key key;
+        Clock::time_point time;
+    };
+
+    explicit KeyQueue(std::size_t capacity = 64);
+
+    bool push(Key key);
+    bool pop(Entry& entry);
+    bool pop_fresh(Key& key, Clock::duration deadline);
+    void clear();
+private:
+    BoundedMpscQueue<Entry> _entries;
+};
+
+}
@@ -0,0 +1,236 @@
+/** @file keywords.h
+ * Vocabulary of SpeechToText: spoken word -> Key.
+ */
+
+#pragma once
+
+#include "key-queue.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace stt {
+
+/**
+ * @struct Keyword
+ * A spoken word and the key it stands for.
+ */
+struct Keyword {
+    std::string_view word;
+    Key key;
+};
+
+/**
+ * Default vocabulary, used when there is no keywords file.
+ * @note Close words that should also be parsed as command (DeepSpeech
+ * near-misses), e.g. "let" -> "left", "but" -> "up". "he" -> "up" is
+ * probably too common.
+ */
+constexpr Keyword DEFAULT_KEYWORDS[] = {
+    {"up", Key::Up},
+    {"but", Key::Up},
+    {"a", Key::Up},
+    {"at", Key::Up},
+    {"down", Key::Down},
+    {"left", Key::Left},
+    {"let", Key::Left},
+    {"last", Key::Left},
+    {"laughed", Key::Left},
+    {"late", Key::Left},
+    // AFTER CUSTOM SCORER:
+    {"le", Key::Left},
+    {"right", Key::Right},
+    {"play", Key::Play},
+    {"exit", Key::Exit},
+};
+
+/**
+ * Take the next space separated word off text, without copying.
+ * @return The word, empty once text has no words left.
+ */
+constexpr std::string_view next_word(std::string_view& text)
+{
+    std::size_t start = text.find_first_not_of(' ');
+    if (start == std::string_view::npos) {
+        text = std::string_view();
+        return text;
+    }
+    std::size_t end = std::min(text.find(' ', start), text.size());
+    std::string_view word = text.substr(start, end - start);
+    text.remove_prefix(end);
+    return word;
+}
+
+/**
+ * @class KeywordTable
+ * Perfect hash table of keywords (hash and displace): a word's first hash
+ * picks a bucket, the bucket's displacement seeds a second hash that picks
+ * the word's slot. Displacements are searched when the table is built so no
+ * two words share a slot, a lookup is then two hashes and one comparison,
+ * O(1) and without allocation.
+ * @remark Built at compile time for DEFAULT_KEYWORDS, at runtime for a
+ * keywords file (same code).
+ */
+class KeywordTable {
+public:
+    static constexpr std::size_t MAX_KEYWORDS = 128;
+
+    constexpr KeywordTable() = default;
+    constexpr KeywordTable(const Keyword* keywords, std::size_t count);
+
+    constexpr Key find(std::string_view word) const;
+    constexpr std::size_t size() const { return _count; }
+private:
+    static constexpr std::size_t BUCKETS = MAX_KEYWORDS;
+    static constexpr std::size_t SLOTS = 2 * MAX_KEYWORDS;
+    // give up on a bucket after this many displacements (never happens for
+    // distinct words at this load)
+    static constexpr std::uint32_t MAX_DISPLACEMENT = 1 << 16;
+
+    static constexpr std::uint32_t hash(std::string_view word,
+                                        std::uint32_t seed);
+
+    std::array<Keyword, SLOTS> _slots{};
+    std::array<std::uint32_t, BUCKETS> _displacements{};
+    std::size_t _count = 0;
+};
+
+/**
+ * FNV-1a, seeded, with a final mix so the low bits (used as index) depend on
+ * every character.
+ */
+constexpr std::uint32_t KeywordTable::hash(std::string_view word,
+        std::uint32_t seed)
+{
+    std::uint32_t h = 2166136261u ^ (seed * 16777619u);
+    for (char c : word) {
+        h ^= static_cast<unsigned char>(c);
+        h *= 16777619u;
+    }
+    h ^= h >> 16;
+    h *= 0x85ebca6bu;
+    h ^= h >> 13;
+    return h;
+}
+
+/**
+ * @throw std::length_error with more than MAX_KEYWORDS keywords.
+ * @throw std::invalid_argument if a word is empty or listed twice.
+ * @note In a constant expression, a throw is a compile error.
+ */
+constexpr KeywordTable::KeywordTable(const Keyword* keywords,
+        std::size_t count) :
+    _count(count)
+{
+    if (count > MAX_KEYWORDS)
+        throw std::length_error("KeywordTable - Too many keywords");
+    for (std::size_t i = 0; i < count; ++i) {
+        if (keywords[i].word.empty())
+            throw std::invalid_argument("KeywordTable - Empty keyword");
+        for (std::size_t j = i + 1; j < count; ++j)
+            if (keywords[i].word == keywords[j].word)
+                throw std::invalid_argument("KeywordTable - Duplicate keyword");
+    }
+
+    std::array<std::size_t, MAX_KEYWORDS> bucket_of{};
+    std::array<std::size_t, BUCKETS> bucket_sizes{};
+    for (std::size_t i = 0; i < count; ++i) {
+        bucket_of[i] = hash(keywords[i].word, 0) & (BUCKETS - 1);
+        ++bucket_sizes[bucket_of[i]];
+    }
+
+    // place the largest buckets first, while most slots are free
+    std::array<std::size_t, BUCKETS> order{};
+    for (std::size_t b = 0; b < BUCKETS; ++b)
+        order[b] = b;
+    std::sort(order.begin(), order.end(), [&] (std::size_t l, std::size_t r) {
+        return bucket_sizes[l] > bucket_sizes[r];
+    });
+
+    std::array<bool, SLOTS> is_taken{};
+    for (std::size_t bucket : order) {
+        if (bucket_sizes[bucket] == 0)
+            break;
+
+        std::uint32_t displacement = 1;
+        for (;; ++displacement) {
+            if (displacement == MAX_DISPLACEMENT)
+                throw std::invalid_argument("KeywordTable - No perfect hash");
+
+            // try every word of the bucket, undo on a collision
+            std::array<std::size_t, MAX_KEYWORDS> placed{};
+            std::size_t placed_count = 0;
+            bool fits = true;
+            for (std::size_t i = 0; i < count && fits; ++i) {
+                if (bucket_of[i] != bucket)
+                    continue;
+                std::size_t slot = hash(keywords[i].word, displacement)
+                    & (SLOTS - 1);
+                if (is_taken[slot]) {
+                    fits = false;
+                } else {
+                    is_taken[slot] = true;
+                    placed[placed_count++] = slot;
+                }
+            }
+            if (fits)
+                break;
+            for (std::size_t p = 0; p < placed_count; ++p)
+                is_taken[placed[p]] = false;
+        }
+
+        _displacements[bucket] = displacement;
+        for (std::size_t i = 0; i < count; ++i)
+            if (bucket_of[i] == bucket)
+                _slots[hash(keywords[i].word, displacement) & (SLOTS - 1)]
+                    = keywords[i];
+    }
+}
+
+/**
+ * @return The key of word, Key::None if word is not a keyword.
+ */
+constexpr Key KeywordTable::find(std::string_view word) const
+{
+    std::uint32_t displacement = _displacements[hash(word, 0) & (BUCKETS - 1)];
+    // empty buckets have no displacement, their words are not keywords
+    if (displacement == 0)
+        return Key::None;
+    const Keyword& slot = _slots[hash(word, displacement) & (SLOTS - 1)];
+    return slot.word == word ? slot.key : Key::None;
+}
+
+/** Compile time table of the default vocabulary. */
+inline constexpr KeywordTable DEFAULT_KEYWORD_TABLE(DEFAULT_KEYWORDS,
+        std::size(DEFAULT_KEYWORDS));
+
+static_assert(DEFAULT_KEYWORD_TABLE.find("left") == Key::Left);
+static_assert(DEFAULT_KEYWORD_TABLE.find("but") == Key::Up);
+static_assert(DEFAULT_KEYWORD_TABLE.find("lefty") == Key::None);
+
+/**
+ * @class Vocabulary
+ * Keyword table that can be loaded from a file, owns the words the table
+ * views.
+ * @warning Not copyable or movable, the table views the owned strings.
+ */
+class Vocabulary {
+public:
+    Vocabulary();
+    Vocabulary(const Vocabulary&) = delete;
+    Vocabulary& operator=(const Vocabulary&) = delete;
+
+    bool load(const std::string& filename);
+    Key find(std::string_view word) const;
+private:
+    std::vector<std::string> _words;
+    KeywordTable _table;
+};
+
+}
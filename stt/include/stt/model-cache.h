@@ -0,0 +1,83 @@
+/** @file model-cache.h
+ * Process-wide cache of DeepSpeech models, shared by SpeechToText instances.
+ */
+
+#pragma once
+
+#include <deepspeech.h>
+
+#include <compare>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace stt {
+
+/**
+ * @struct ModelConfig
+ * Everything a model is created with. Settings of a DeepSpeech model are
+ * shared by all of its streams, so models with different settings are
+ * different cache entries.
+ */
+struct ModelConfig {
+    std::string model_path;
+    std::string scorer_path;
+    unsigned int beam_width;
+    std::vector<std::string> hot_words;
+    float hot_word_boost;
+
+    auto operator<=>(const ModelConfig&) const = default;
+};
+
+/**
+ * @class ModelCache
+ * Creates each model once and hands out shared references to it, the model
+ * is freed (DS_FreeModel) when its last user releases it. Every user then
+ * only owns its own lightweight stream (DS_CreateStream).
+ * @remark Thread-safe. Models load on a worker thread, every caller asking
+ * for a model that is loading gets the same future, so a model is never
+ * loaded twice and callers never have to wait on a render thread.
+ * @remark Loaders are never detached: exiting while a model loads waits for
+ * the load when the cache is destroyed (static destruction).
+ */
+class ModelCache {
+public:
+    using Model = std::shared_ptr<ModelState>;
+
+    static std::shared_future<Model> acquire_async(const ModelConfig& config);
+    static Model acquire(const ModelConfig& config);
+private:
+    /**
+     * @struct Entry
+     * The model if someone holds it, or its load if it is loading (only while
+     * loading, the future holds a reference to the model).
+     */
+    struct Entry {
+        std::weak_ptr<ModelState> model;
+        std::shared_future<Model> loading;
+    };
+
+    /**
+     * @struct State
+     * The cache, a function-local static (see get_state()) so it outlives
+     * every caller. Its loaders are destroyed first, which joins them while
+     * the map and mutex they use are still alive.
+     */
+    struct State {
+        std::mutex mtx;
+        std::map<ModelConfig, Entry> models;
+        /// One per load (a few per run), declared last to be joined first.
+        std::vector<std::jthread> loaders;
+    };
+
+    static State& get_state();
+    static Model create(const ModelConfig& config);
+    static void load(ModelConfig config, std::shared_ptr<std::promise<Model>>
+            promise);
+};
+
+}
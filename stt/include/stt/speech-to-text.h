@@ -6,44 +6,52 @@
 
 #pragma once
 
+#include "audio-source.h"
+#include "key-queue.h"
+#include "keywords.h"
+#include "model-cache.h"
+#include "trace-hook.h"
+#include "voice-activity.h"
+
 #include <deepspeech.h>
-#include <SFML/Audio/SoundBufferRecorder.hpp>
 
+#include <atomic>
 #include <string>
-#include <queue>
+#include <string_view>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <stop_token>
+#include <vector>
 
 namespace stt {
 
-/** @todo Sort KeyQueue class or just use std::queue. Weight benefits of 
- * wrapper and design of API. Design of API is a big TODO, but going for single
- * header, everything-included API right now.
- * @remark Uses native KeyQueue as a wrapper for internal key std::queue. */
-//class KeyQueue;
-
-/** @enum Key
-*  Interface to obtain key pressed from SpeechToText.
-*  @remark Size of enum is defined, to be forwarded.
-*/
-enum class Key {
-    None = -1,
-    A = 0,
-    Up,
-    Down,
-    Left,
-    Right,
-    Play,
-    Exit,
-};
-
 class SpeechToText {
 public:
-    SpeechToText();
+    /**
+    * @enum Mode
+    * Transcribe decodes free speech and takes words as they are decoded.
+    * Spot only listens for the vocabulary: narrow beam, command words boosted,
+    * and a word is only taken at the end of an utterance if enough of the
+    * N-best transcripts agree on it (its confidence).
+    */
+    enum class Mode {
+        Transcribe,
+        Spot,
+    };
+
+    explicit SpeechToText(Mode mode = Mode::Transcribe);
+    SpeechToText(Mode mode, const ModelConfig& config,
+                 std::unique_ptr<AudioSource> source = nullptr);
     ~SpeechToText();
 
+    /** Model settings SpeechToText(mode) uses. */
+    static ModelConfig default_model_config(Mode mode);
+
     /**
      * @struct AudioBuffer
-     * SpeechToText AudioBuffer to store sf::SoundBuffer in a better API for 
-     * DeepSpeech. 
+     * SpeechToText AudioBuffer to store captured samples in a better API for
+     * DeepSpeech.
      */
     struct AudioBuffer {
         unsigned int channels;
@@ -60,37 +68,77 @@ public:
         Stereo = 2,
     };
     
-    void run();
+    void run(std::stop_token stop = std::stop_token());
+    void feed(const short* samples, std::size_t count);
+    bool is_ready() const;
     std::string get_decoded();
     void clear();
 
-    /** Get the next key. */
-    Key get_key();
-    /** Check if there are keys to get. */
-    bool key_queue_is_empty() const;
+    /** Get the next key, false if there is none (never waits). */
+    bool poll_key(Key& key);
+    /** Keys older than deadline are discarded by poll_key(). */
+    void set_key_deadline(std::chrono::milliseconds deadline);
+    /** Spot mode: least confidence (0 to 1) for a word to be taken. */
+    void set_spot_threshold(double threshold);
     
     /** @todo Need? Get what type of key the current key is. */
     //static bool is_key_pressed(Key key);
 private:
-    void record();
+    std::size_t record();
+    void finish_utterance();
+    void listen(const short* samples, std::size_t count);
     void decode();
     void parse();
+    void take_words(std::string_view transcript, bool is_final);
+    void spot_words(const Metadata& metadata);
+    bool attach_model();
+    void open_stream();
+    void close_stream();
 
+    Mode _mode;
+    double _spot_threshold;
+    /**
+    * @var std::shared_future<ModelCache::Model> _model_ready
+    * The model loading on a worker thread since construction, run() takes
+    * _model from it.
+    */
+    std::shared_future<ModelCache::Model> _model_ready;
+    /// Shared with other SpeechToText instances, _ctx views it.
+    std::shared_ptr<ModelState> _model;
     ModelState* _ctx;
     StreamingState* _sctx;
-    const char* _mpath;
-    const char* _spath;
     int _sample_rate;
     AudioBuffer _buf;
+    /// Read from the recorder's ring, sized once.
+    std::vector<short> _samples;
+    /// Part of _samples that is speech, what DeepSpeech decodes.
+    std::vector<short> _voiced;
+    /**
+    * @var std::string _decoded
+    * Words decoded since the last parse() (not the whole stream transcript).
+    */
     std::string _decoded;
-    sf::SoundBufferRecorder _recorder;
-    std::queue<Key> _key_queue;
-    
+    /// Last intermediate transcript of the stream.
+    std::string _transcript;
+    /// Words of _transcript already parsed.
+    std::size_t _emitted_words;
+    /// What run() decodes, the microphone unless told otherwise.
+    std::unique_ptr<AudioSource> _source;
+    VoiceActivity _vad;
+    Vocabulary _vocabulary;
+    /**
+    * @var KeyQueue _key_queue
+    * Pushed by parse() on the run() thread, popped by the game thread.
+    */
+    KeyQueue _key_queue;
+    std::chrono::milliseconds _key_deadline;
+
     /**
-    * @var bool _run
+    * @var std::atomic<bool> _run
     * Flag to confirm that SpeechToText should run (i.e., is not cleared).
+    * @note Set by clear() on another thread than run().
     */
-    bool _run;
+    std::atomic<bool> _run;
 };
 
 }
@@ -0,0 +1,118 @@
+/** @file spsc-ring.h
+ * Lock-free single-producer/single-consumer ring buffer.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace stt {
+
+/**
+ * @class SpscRing
+ * Fixed capacity ring of T, one thread pushes and one other thread pops.
+ * Neither side locks or allocates, the storage is allocated once.
+ * @remark Head and tail only grow (wrapping std::size_t is fine, the
+ * capacity is a power of 2), their difference is the size.
+ * @warning Only one producer and one consumer thread.
+ */
+template <typename T>
+class SpscRing {
+public:
+    explicit SpscRing(std::size_t capacity);
+
+    std::size_t push(const T* items, std::size_t count);
+    std::size_t pop(T* items, std::size_t count);
+    std::size_t size() const;
+    std::size_t capacity() const;
+private:
+    // keep the indices on separate cache lines, no false sharing
+    static constexpr std::size_t CACHE_LINE = 64;
+
+    std::vector<T> _items;
+    std::size_t _mask;
+    /// Next write, written by the producer only.
+    alignas(CACHE_LINE) std::atomic<std::size_t> _head;
+    /// Next read, written by the consumer only.
+    alignas(CACHE_LINE) std::atomic<std::size_t> _tail;
+};
+
+/**
+ * @param std::size_t capacity
+ * Rounded up to a power of 2.
+ */
+template <typename T>
+SpscRing<T>::SpscRing(std::size_t capacity) :
+    _items(),
+    _mask(0),
+    _head(0),
+    _tail(0)
+{
+    std::size_t size = 1;
+    while (size < capacity)
+        size <<= 1;
+    _items.resize(size);
+    _mask = size - 1;
+}
+
+/**
+ * Producer: copy as many items as there is room for.
+ * @return Number of items pushed, less than count if the ring is full.
+ */
+template <typename T>
+std::size_t SpscRing<T>::push(const T* items, std::size_t count)
+{
+    std::size_t head = _head.load(std::memory_order_relaxed);
+    std::size_t tail = _tail.load(std::memory_order_acquire);
+    count = std::min(count, _items.size() - (head - tail));
+
+    // copy up to the end of the storage, then wrap to its start
+    std::size_t start = head & _mask;
+    std::size_t first = std::min(count, _items.size() - start);
+    std::copy(items, items + first, _items.begin() + start);
+    std::copy(items + first, items + count, _items.begin());
+
+    _head.store(head + count, std::memory_order_release);
+    return count;
+}
+
+/**
+ * Consumer: copy up to count items out.
+ * @return Number of items popped, 0 if the ring is empty.
+ */
+template <typename T>
+std::size_t SpscRing<T>::pop(T* items, std::size_t count)
+{
+    std::size_t tail = _tail.load(std::memory_order_relaxed);
+    std::size_t head = _head.load(std::memory_order_acquire);
+    count = std::min(count, head - tail);
+
+    std::size_t start = tail & _mask;
+    std::size_t first = std::min(count, _items.size() - start);
+    std::copy(_items.begin() + start, _items.begin() + start + first, items);
+    std::copy(_items.begin(), _items.begin() + (count - first), items + first);
+
+    _tail.store(tail + count, std::memory_order_release);
+    return count;
+}
+
+/**
+ * @return Items in the ring, a snapshot when called from another thread.
+ */
+template <typename T>
+std::size_t SpscRing<T>::size() const
+{
+    return _head.load(std::memory_order_acquire)
+        - _tail.load(std::memory_order_acquire);
+}
+
+template <typename T>
+std::size_t SpscRing<T>::capacity() const
+{
+    return _items.size();
+}
+
+}
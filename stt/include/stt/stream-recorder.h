@@ -0,0 +1,42 @@
+/** @file stream-recorder.h
+ * Microphone capture for streaming decodes.
+ */
+
+#pragma once
+
+#include "spsc-ring.h"
+
+#include <SFML/Audio/SoundRecorder.hpp>
+#include <SFML/System/Time.hpp>
+
+#include <atomic>
+#include <cstddef>
+
+namespace stt {
+
+/**
+ * @class StreamRecorder
+ * sf::SoundRecorder that writes captured samples into a lock-free ring, the
+ * decoder drains it with read(). Capture keeps going while the decoder
+ * decodes, nothing is lost unless the decoder falls behind by more than the
+ * ring holds (2s).
+ * @note onProcessSamples() runs on SFML's capture thread (the producer),
+ * read() on the decoding thread (the consumer).
+ */
+class StreamRecorder : public sf::SoundRecorder {
+public:
+    StreamRecorder();
+    ~StreamRecorder();
+
+    std::size_t read(short* samples, std::size_t count, sf::Time timeout);
+    std::size_t get_dropped_count() const;
+private:
+    virtual bool onProcessSamples(const sf::Int16* samples,
+                                  std::size_t count);
+
+    SpscRing<short> _ring;
+    /// Samples that did not fit in the ring, i.e. lost.
+    std::atomic<std::size_t> _dropped;
+};
+
+}
@@ -0,0 +1,39 @@
+/** @file trace-hook.h
+ * Lets the application trace SpeechToText stages (e.g., into its Chrome
+ * trace, see trace.h of the game) without stt depending on it.
+ */
+
+#pragma once
+
+#include <chrono>
+
+namespace stt {
+
+/**
+ * Receives a finished span: a static name, and when it began and ended.
+ * Called on the thread that ran the span.
+ */
+using TraceHook = void (*)(const char* name,
+        std::chrono::steady_clock::time_point begin,
+        std::chrono::steady_clock::time_point end);
+
+void set_trace_hook(TraceHook hook);
+
+/**
+ * @class TraceSpan
+ * Reports its scope to the trace hook, if one is set.
+ */
+class TraceSpan {
+public:
+    explicit TraceSpan(const char* name);
+    ~TraceSpan();
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+private:
+    const char* _name;
+    TraceHook _hook;
+    std::chrono::steady_clock::time_point _begin;
+};
+
+}
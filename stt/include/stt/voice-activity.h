@@ -0,0 +1,46 @@
+/** @file voice-activity.h
+ * Voice activity detection, keeps silence away from the decoder.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace stt {
+
+/**
+ * @class VoiceActivity
+ * Energy and zero-crossing voice activity detector. Audio is split in 20ms
+ * frames, a frame is voiced when its energy is well above the (adaptive)
+ * noise floor, or somewhat above it with a high zero-crossing rate (unvoiced
+ * consonants, e.g. the "f" of "left").
+ * Only utterances are passed on: a short pre-roll before the first voiced
+ * frame, and a hangover after the last one so words are not clipped.
+ */
+class VoiceActivity {
+public:
+    explicit VoiceActivity(int sample_rate);
+
+    void process(const short* samples, std::size_t count,
+                 std::vector<short>& voiced);
+    bool is_speaking() const;
+    bool take_utterance_end();
+    void reset();
+private:
+    bool is_voiced(double energy, double zero_crossings) const;
+    void process_frame(std::vector<short>& voiced);
+
+    std::size_t _frame_size;
+    std::vector<short> _frame;
+    // last frames before an onset, sent with the utterance
+    std::vector<short> _preroll;
+    double _noise_energy;
+    bool _is_speaking;
+    bool _utterance_ended;
+    int _voiced_frames;
+    int _silent_frames;
+    int _utterance_frames;
+};
+
+}
@@ -0,0 +1,271 @@
+#include "audio-source.h"
+
+#include <SFML/System/Sleep.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+namespace {
+    // read() polls this often while real-time samples are not due yet
+    const sf::Time POLL_INTERVAL = sf::milliseconds(5);
+    const double PI = 3.14159265358979323846;
+
+    /// Samples due by now at real-time pace, that were not played yet.
+    std::size_t due_samples(const sf::Clock& clock, unsigned int sample_rate,
+            std::size_t played)
+    {
+        std::size_t due = static_cast<std::size_t>(
+                clock.getElapsedTime().asMicroseconds()
+                * static_cast<sf::Int64>(sample_rate) / 1000000);
+        return due > played ? due - played : 0;
+    }
+
+    /**
+     * How many of count samples may be read now, waits (at most timeout) for
+     * some to be due at real-time pace.
+     */
+    std::size_t pace_samples(stt::AudioSource::Pace pace,
+            const sf::Clock& clock, unsigned int sample_rate,
+            std::size_t played, std::size_t count, sf::Time timeout)
+    {
+        if (pace == stt::AudioSource::Pace::MaxSpeed)
+            return count;
+        sf::Clock waited;
+        for (;;) {
+            std::size_t due = due_samples(clock, sample_rate, played);
+            if (due > 0 || waited.getElapsedTime() >= timeout)
+                return std::min(due, count);
+            sf::sleep(POLL_INTERVAL);
+        }
+    }
+
+    bool is_raw_file(const std::string& filename)
+    {
+        std::string extension = filename.substr(
+                std::min(filename.rfind('.'), filename.size()));
+        std::transform(extension.begin(), extension.end(), extension.begin(),
+                [] (unsigned char c) { return std::tolower(c); });
+        return extension == ".raw" || extension == ".pcm";
+    }
+}
+
+bool stt::AudioSource::is_finished() const
+{
+    return false;
+}
+
+std::size_t stt::AudioSource::get_dropped_count() const
+{
+    return 0;
+}
+
+stt::MicrophoneSource::MicrophoneSource() :
+    _recorder()
+{
+    _recorder.setChannelCount(1);
+}
+
+/**
+ * @return False if there is no capture device.
+ */
+bool stt::MicrophoneSource::start(unsigned int sample_rate)
+{
+    // first check if an input audio device is available on the system
+    if (!sf::SoundRecorder::isAvailable()) {
+        std::cerr << "Audio capture is not available on this system.\n";
+        return false;
+    }
+    return _recorder.start(sample_rate);
+}
+
+void stt::MicrophoneSource::stop()
+{
+    _recorder.stop();
+}
+
+std::size_t stt::MicrophoneSource::read(short* samples, std::size_t count,
+        sf::Time timeout)
+{
+    return _recorder.read(samples, count, timeout);
+}
+
+std::size_t stt::MicrophoneSource::get_dropped_count() const
+{
+    return _recorder.get_dropped_count();
+}
+
+/**
+ * @param const std::string& filename
+ * Opened by start().
+ */
+stt::FileSource::FileSource(const std::string& filename, Pace pace) :
+    _filename(filename),
+    _pace(pace),
+    _is_raw(is_raw_file(filename)),
+    _file(),
+    _raw(),
+    _sample_rate(0),
+    _clock(),
+    _played(0),
+    _is_finished(false)
+{}
+
+/**
+ * Open the file (again, playback starts over).
+ * @return False if it can't be opened, or isn't mono at sample_rate.
+ */
+bool stt::FileSource::start(unsigned int sample_rate)
+{
+    _sample_rate = sample_rate;
+    _played = 0;
+    _is_finished = false;
+
+    bool is_open = false;
+    if (_is_raw) {
+        _raw.close();
+        _raw.clear();
+        _raw.open(_filename, std::ios::binary);
+        is_open = _raw.is_open();
+    } else if (_file.openFromFile(_filename)) {
+        is_open = true;
+        if (_file.getSampleRate() != sample_rate
+                || _file.getChannelCount() != 1) {
+            std::cerr << "FileSource::start - " << _filename << " is not mono "
+                << sample_rate << " Hz.\n";
+            return false;
+        }
+    }
+    if (!is_open) {
+        std::cerr << "FileSource::start - Failed to open " << _filename
+            << ".\n";
+        return false;
+    }
+    _clock.restart();
+    return true;
+}
+
+void stt::FileSource::stop()
+{
+    _raw.close();
+}
+
+std::size_t stt::FileSource::read(short* samples, std::size_t count,
+        sf::Time timeout)
+{
+    if (_is_finished)
+        return 0;
+    count = pace_samples(_pace, _clock, _sample_rate, _played, count, timeout);
+    if (count == 0)
+        return 0;
+
+    std::size_t read = read_file(samples, count);
+    if (read == 0)
+        _is_finished = true;
+    _played += read;
+    return read;
+}
+
+bool stt::FileSource::is_finished() const
+{
+    return _is_finished;
+}
+
+/**
+ * @note Raw samples are read in host byte order (little-endian on the
+ * platforms we build for).
+ */
+std::size_t stt::FileSource::read_file(short* samples, std::size_t count)
+{
+    if (!_is_raw)
+        return static_cast<std::size_t>(_file.read(samples, count));
+    if (!_raw.is_open())
+        return 0;
+    _raw.read(reinterpret_cast<char*>(samples),
+            static_cast<std::streamsize>(count * sizeof(short)));
+    return static_cast<std::size_t>(_raw.gcount()) / sizeof(short);
+}
+
+stt::SyntheticSource::SyntheticSource(const Settings& settings, Pace pace) :
+    _settings(settings),
+    _pace(pace),
+    _sample_rate(0),
+    _clock(),
+    _played(0),
+    _total(0),
+    _phase(0.0),
+    _noise_state(settings.seed != 0 ? settings.seed : 1)
+{}
+
+/**
+ * Start the stream over (same samples for the same seed).
+ */
+bool stt::SyntheticSource::start(unsigned int sample_rate)
+{
+    _sample_rate = sample_rate;
+    _played = 0;
+    _phase = 0.0;
+    _noise_state = _settings.seed != 0 ? _settings.seed : 1;
+    _total = _settings.duration == sf::Time::Zero
+        ? std::numeric_limits<std::size_t>::max()
+        : static_cast<std::size_t>(_settings.duration.asSeconds()
+                * static_cast<float>(sample_rate));
+    _clock.restart();
+    return sample_rate > 0;
+}
+
+void stt::SyntheticSource::stop()
+{}
+
+std::size_t stt::SyntheticSource::read(short* samples, std::size_t count,
+        sf::Time timeout)
+{
+    count = std::min(count, _total - _played);
+    count = pace_samples(_pace, _clock, _sample_rate, _played, count, timeout);
+    for (std::size_t i = 0; i < count; ++i)
+        samples[i] = next_sample();
+    return count;
+}
+
+bool stt::SyntheticSource::is_finished() const
+{
+    return _played >= _total;
+}
+
+/**
+ * Burst: fundamental gliding from 120 to 180 Hz with 3 overtones, under a
+ * half-sine envelope. Gap: only the background noise.
+ */
+short stt::SyntheticSource::next_sample()
+{
+    const double rate = static_cast<double>(_sample_rate);
+    const std::size_t burst = static_cast<std::size_t>(
+            _settings.burst.asSeconds() * rate);
+    const std::size_t period = burst + static_cast<std::size_t>(
+            _settings.gap.asSeconds() * rate);
+    const std::size_t position = period > 0 ? _played % period : 0;
+    ++_played;
+
+    // xorshift32, uniform in [-noise, noise]
+    _noise_state ^= _noise_state << 13;
+    _noise_state ^= _noise_state >> 17;
+    _noise_state ^= _noise_state << 5;
+    double value = (static_cast<double>(_noise_state) / 4294967295.0 * 2.0
+            - 1.0) * _settings.noise;
+
+    if (position < burst) {
+        double progress = static_cast<double>(position)
+            / static_cast<double>(burst);
+        double envelope = std::sin(PI * progress);
+        _phase += (120.0 + 60.0 * progress) / rate;
+        _phase -= std::floor(_phase);
+        double tone = std::sin(2.0 * PI * _phase)
+            + 0.6 * std::sin(4.0 * PI * _phase)
+            + 0.4 * std::sin(6.0 * PI * _phase)
+            + 0.25 * std::sin(8.0 * PI * _phase);
+        value += _settings.amplitude * envelope * tone / 2.25;
+    }
+    return static_cast<short>(std::clamp(value, -32768.0, 32767.0));
+}
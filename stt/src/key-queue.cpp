@@ -0,0 +1,56 @@
+#include "key-queue.h"
+
+/**
+ * @param std::size_t capacity
+ * Rounded up to a power of 2.
+ */
+stt::KeyQueue::KeyQueue(std::size_t capacity) :
+    _entries(capacity)
+{}
+
+/**
+ * Push a key, stamped with the current time. Safe from any thread.
+ * @return False if the queue is full (the key is dropped).
+ */
+bool stt::KeyQueue::push(Key key)
+{
+    return _entries.push(Entry{key, Clock::now()});
+}
+
+/**
+ * Pop the oldest key. Consumer thread only, never waits.
+ * @return False if the queue is empty (or its oldest key is still being
+ * written).
+ */
+bool stt::KeyQueue::pop(Entry& entry)
+{
+    return _entries.pop(entry);
+}
+
+/**
+ * Pop the oldest key that is not older than deadline, stale keys are
+ * discarded (e.g., spoken while the game was paused).
+ * @return False if there is no fresh key.
+ */
+bool stt::KeyQueue::pop_fresh(Key& key, Clock::duration deadline)
+{
+    Clock::time_point oldest = Clock::now() - deadline;
+    Entry entry;
+    while (pop(entry)) {
+        if (entry.time >= oldest) {
+            key = entry.key;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Discard every key. Consumer thread only.
+ */
+void stt::KeyQueue::clear()
+{
+    Entry entry;
+    while (pop(entry))
+        ;
+}
@@ -0,0 +1,89 @@
+#include "keywords.h"
+
+#include <fstream>
+#include <sstream>
+
+namespace {
+    /// Names of keys in a keywords file.
+    constexpr stt::Keyword KEY_NAMES[] = {
+        {"up", stt::Key::Up},
+        {"down", stt::Key::Down},
+        {"left", stt::Key::Left},
+        {"right", stt::Key::Right},
+        {"play", stt::Key::Play},
+        {"exit", stt::Key::Exit},
+    };
+
+    stt::Key find_key_name(std::string_view name)
+    {
+        for (const stt::Keyword& key_name : KEY_NAMES)
+            if (key_name.word == name)
+                return key_name.key;
+        return stt::Key::None;
+    }
+}
+
+stt::Vocabulary::Vocabulary() :
+    _words(),
+    _table(DEFAULT_KEYWORD_TABLE)
+{}
+
+/**
+ * Replace the vocabulary with the one of a keywords file. One keyword per
+ * line: the spoken word then the key name (up, down, left, right, play,
+ * exit), # starts a comment.
+ * @code
+ * # near-miss of "left"
+ * let left
+ * @endcode
+ * @return False if the file can't be opened (the vocabulary is unchanged).
+ * @throw std::runtime_error if the file is malformed.
+ */
+bool stt::Vocabulary::load(const std::string& filename)
+{
+    std::ifstream file(filename);
+    if (!file)
+        return false;
+
+    // read every string first, views are only taken once _words is final
+    std::vector<std::string> words;
+    std::vector<Key> keys;
+    std::string line;
+    for (int number = 1; std::getline(file, line); ++number) {
+        line = line.substr(0, line.find('#'));
+        std::istringstream in(line);
+        std::string word, name;
+        if (!(in >> word))
+            continue;
+
+        Key key = in >> name ? find_key_name(name) : Key::None;
+        if (key == Key::None)
+            throw std::runtime_error("Vocabulary::load - Bad keyword in "
+                    + filename + " line " + std::to_string(number));
+        words.push_back(word);
+        keys.push_back(key);
+    }
+
+    std::vector<Keyword> keywords;
+    for (std::size_t i = 0; i < words.size(); ++i)
+        keywords.push_back(Keyword{words[i], keys[i]});
+    try {
+        _table = KeywordTable(keywords.data(), keywords.size());
+    } catch (const std::logic_error& e) {
+        throw std::runtime_error("Vocabulary::load - " + filename + ": "
+                + e.what());
+    }
+
+    // swap keeps the string objects in place (views stay valid), moving
+    // them would not for short strings stored inline
+    _words.swap(words);
+    return true;
+}
+
+/**
+ * @return The key of word, Key::None if word is not a keyword.
+ */
+stt::Key stt::Vocabulary::find(std::string_view word) const
+{
+    return _table.find(word);
+}
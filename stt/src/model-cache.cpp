@@ -0,0 +1,119 @@
+#include "model-cache.h"
+#include "trace-hook.h"
+
+#include <stdexcept>
+#include <thread>
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * @return The cache, created on first use and destroyed after main() (the
+ * destructor joins loads still going).
+ */
+stt::ModelCache::State& stt::ModelCache::get_state()
+{
+    static State state;
+    return state;
+}
+
+/**
+ * Get the model of config without waiting: ready if someone holds it, else
+ * its load is started (or joined, if it is already loading) on a worker
+ * thread.
+ * @return Future of the model, get() throws std::runtime_error if the model
+ * can't be created.
+ */
+std::shared_future<stt::ModelCache::Model> stt::ModelCache::acquire_async(
+        const ModelConfig& config)
+{
+    State& state = get_state();
+    std::lock_guard<std::mutex> lock(state.mtx);
+    Entry& entry = state.models[config];
+    if (Model model = entry.model.lock()) {
+        std::promise<Model> ready;
+        ready.set_value(std::move(model));
+        return ready.get_future().share();
+    }
+
+    if (!entry.loading.valid()) {
+        // a promise, not std::async: the last std::async future blocks on
+        // destruction, and load() drops the cache's one from the worker
+        auto promise = std::make_shared<std::promise<Model>>();
+        entry.loading = promise->get_future().share();
+        state.loaders.emplace_back(&ModelCache::load, config, promise);
+    }
+    return entry.loading;
+}
+
+/**
+ * Get the model of config, waits if it has to be loaded.
+ * @throw std::runtime_error if the model can't be created.
+ */
+stt::ModelCache::Model stt::ModelCache::acquire(const ModelConfig& config)
+{
+    return acquire_async(config).get();
+}
+
+/**
+ * Loader thread of acquire_async(), joined by the cache's destruction.
+ */
+void stt::ModelCache::load(ModelConfig config,
+        std::shared_ptr<std::promise<Model>> promise)
+{
+    State& state = get_state();
+    Model model;
+    try {
+        model = create(config);
+    } catch (...) {
+        {
+            std::lock_guard<std::mutex> lock(state.mtx);
+            state.models[config].loading = std::shared_future<Model>();
+        }
+        promise->set_exception(std::current_exception());
+        return;
+    }
+
+    {
+        // from now on the model lives as long as somebody holds it
+        std::lock_guard<std::mutex> lock(state.mtx);
+        Entry& entry = state.models[config];
+        entry.model = model;
+        entry.loading = std::shared_future<Model>();
+    }
+    promise->set_value(std::move(model));
+}
+
+stt::ModelCache::Model stt::ModelCache::create(const ModelConfig& config)
+{
+    TraceSpan span("stt::ModelCache::create");
+    /** @brief Create DeepSpeech model with model path and model context. */
+    ModelState* ctx = nullptr;
+    int status = DS_CreateModel(config.model_path.c_str(), &ctx);
+    if (status != 0) {
+        char* error = DS_ErrorCodeToErrorMessage(status);
+        std::string message = error;
+        free(error);
+        throw std::runtime_error("ModelCache::create - Could not create model "
+                + config.model_path + ": " + message);
+    }
+    // freed with the last reference
+    Model model(ctx, DS_FreeModel);
+
+    /** @brief Add DeepSpeech scorer to model context. */
+    status = DS_EnableExternalScorer(ctx, config.scorer_path.c_str());
+    if (status != 0)
+        fprintf(stderr, "Could not enable external scorer.\n");
+
+    /** @brief Set model beam width (is set to a low value for faster
+     * decodes, don't need complicated sentence structure). */
+    status = DS_SetModelBeamWidth(ctx, config.beam_width);
+    if (status != 0)
+        fprintf(stderr, "Could not set model beam width.\n");
+
+    for (const std::string& hot_word : config.hot_words) {
+        status = DS_AddHotWord(ctx, hot_word.c_str(), config.hot_word_boost);
+        if (status != 0)
+            fprintf(stderr, "Could not add hot-word %s.\n", hot_word.c_str());
+    }
+    return model;
+}
@@ -18,10 +18,12 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 
+#include <algorithm>
+#include <cmath>
 #include <vector>
 #include <iostream>
 #include <cassert>
-#include <sstream>
+#include <string_view>
 
 static const char MODEL_PATH[] =
     "../dep/deepspeech-models/deepspeech-0.9.3-models.pbmm";
@@ -29,53 +31,84 @@ static const char SCORER_PATH[] =
     //"../dep/deepspeech-models/deepspeech-0.9.3-models.scorer";
     "../dep/deepspeech-models/kenlm-no-a.scorer";
 
-stt::SpeechToText::SpeechToText() :
-    _mpath(MODEL_PATH),
-    _spath(SCORER_PATH),
+/** @brief Wait at most this long for captured samples, so clear() is seen. */
+static const sf::Time READ_TIMEOUT = sf::milliseconds(100);
+/** @brief Default age after which a recognized key is stale. */
+static const std::chrono::milliseconds KEY_DEADLINE(1000);
+/** @brief Optional vocabulary, DEFAULT_KEYWORDS are used without it. */
+static const char KEYWORDS_PATH[] = "stt/keywords.txt";
+/** @brief Spot mode: beam width, transcripts compared, and default least
+ * share of them (weighted by confidence) that must hold a word. */
+static const unsigned int SPOT_BEAM_WIDTH = 16;
+static const unsigned int SPOT_CANDIDATES = 5;
+static const double SPOT_THRESHOLD = 0.6;
+/** @brief Spot mode: command words boosted in the beam search (NOTE: 8-10
+ * tested best, 9 ideal). Near-miss aliases are not boosted, they would
+ * trigger more. */
+static const char* const SPOT_HOT_WORDS[] = {
+    "up", "down", "left", "right", "play", "exit",
+};
+static const float SPOT_HOT_WORD_BOOST = 9.f;
+/** @brief Most samples taken from the capture ring per record() (256ms). */
+static const std::size_t READ_SAMPLES = 4096;
+
+/**
+ * @param Mode mode
+ * Mode::Spot for command input (cheaper, fewer false keys), Mode::Transcribe
+ * to decode everything said.
+ */
+stt::SpeechToText::SpeechToText(Mode mode) :
+    SpeechToText(mode, default_model_config(mode))
+{}
+
+/**
+ * @param const ModelConfig& config
+ * Model settings other than the mode's defaults (e.g., to tune the beam width
+ * or try another scorer), see default_model_config().
+ * @param std::unique_ptr<AudioSource> source
+ * What run() decodes (e.g., a FileSource to test without a microphone),
+ * nullptr for the microphone.
+ */
+stt::SpeechToText::SpeechToText(Mode mode, const ModelConfig& config,
+        std::unique_ptr<AudioSource> source) :
+    _mode(mode),
+    _spot_threshold(SPOT_THRESHOLD),
+    _model_ready(),
+    _model(),
     _ctx(),
     _sctx(),
     _sample_rate(16000),
     _buf(),
+    _samples(READ_SAMPLES),
+    _voiced(),
     _decoded(), // xxx std::optional to handle empty string instantiation (?)
-    _recorder(),
+    _transcript(),
+    _emitted_words(0),
+    _source(source ? std::move(source)
+            : std::make_unique<MicrophoneSource>()),
+    _vad(_sample_rate),
+    _vocabulary(),
     _key_queue(),
-    _run()
+    _key_deadline(KEY_DEADLINE),
+    _run(false)
 {
     /** @brief Instantiate AudioBuffer.
-     * @note Only channels are known (Channels::Mono), sf::SoundBuffer will
+     * @note Only channels are known (Channels::Mono), listen() will
      * instantiate samples and count. */
     _buf.channels = static_cast<unsigned int>(Channels::Mono);
+    /** @brief Allocate once, no allocation between capture and decode. One
+     * read plus the VAD pre-roll always fits in a second of audio. */
+    _voiced.reserve(static_cast<std::size_t>(_sample_rate));
 
-    /** @brief Create DeepSpeech model with model path and model context. */
-    int status = DS_CreateModel(_mpath, &_ctx);
-    if (status != 0) {
-        char* error = DS_ErrorCodeToErrorMessage(status);
-        fprintf(stderr, "Could not create model: %s\n", error);
-        free(error);
-        // xxx need to try-catch block (?), might not work - or init in init()
-        //return 1;
-    }
-
-    /** @brief Add DeepSpeech scorer to model context. */
-    status = DS_EnableExternalScorer(_ctx, _spath);
-    if (status != 0) {
-        fprintf(stderr, "Could not enable external scorer.\n");
-        // xxx need to try-catch block (?), might not work - or init in init()
-        //return 1;
-    }
-
-    // _sample_rate is used to set SFML sample rate, needs to match DS
-    // sample rate
-    assert(DS_GetModelSampleRate(_ctx) == _sample_rate);
+    /** @brief Words to keys, from the keywords file if there is one. */
+    if (_vocabulary.load(KEYWORDS_PATH))
+        std::cout << "SpeechToText vocabulary loaded from " << KEYWORDS_PATH
+            << "\n";
 
-    // first check if an input audio device is available on the system
-    if (!sf::SoundBufferRecorder::isAvailable()) {
-        std::cerr << "Audio capture is not available on this system.\n";
-    }
-
-    // xxx static_cast? what's the point of the enum, sort out better
-    // (SEE: struct AudioBuffer instantiation)
-    _recorder.setChannelCount(_buf.channels);
+    /** @brief Borrow the DeepSpeech model from the process-wide cache, only
+     * the first SpeechToText with these settings loads it, on a worker
+     * thread: constructing never waits for the model, run() does. */
+    _model_ready = ModelCache::acquire_async(config);
 
     /** @brief This should be addressed... */
     #if defined(__GNUC__) || defined(__GNUG__)
@@ -126,17 +159,6 @@ stt::SpeechToText::SpeechToText() :
         #pragma GCC diagnostic pop
     #endif
 
-    /** @brief Set model beam width in SpeechToText constructor (is set to a low
-     * value for faster decodes, don't need complicated sentence structure). */
-
-    // xxx figure out best beam width. NOTE: 100 was a MASSIVE improvement to
-    // decode speed
-    int beam_width = 75;
-    status = DS_SetModelBeamWidth(_ctx, beam_width);
-    if (status != 0) {
-        fprintf(stderr, "Could not set model beam width.\n");
-    }
-
     // xxx mess with alpha/beta
     // how much to weight external scorer words
     int alpha = 0;
@@ -150,72 +172,333 @@ stt::SpeechToText::SpeechToText() :
     //}
 }
 
+/**
+ * Model settings of the mode, SpeechToText instances with the same settings
+ * share one model.
+ */
+stt::ModelConfig stt::SpeechToText::default_model_config(Mode mode)
+{
+    ModelConfig config;
+    config.model_path = MODEL_PATH;
+    config.scorer_path = SCORER_PATH;
+
+    /** @brief Set model beam width (is set to a low value for faster
+     * decodes, don't need complicated sentence structure). */
+    // xxx figure out best beam width. NOTE: 100 was a MASSIVE improvement to
+    // decode speed
+    config.beam_width = 75;
+    config.hot_word_boost = SPOT_HOT_WORD_BOOST;
+
+    // spot mode only tells a handful of words apart, a narrow beam will do
+    if (mode == Mode::Spot) {
+        config.beam_width = SPOT_BEAM_WIDTH;
+        config.hot_words.assign(std::begin(SPOT_HOT_WORDS),
+                std::end(SPOT_HOT_WORDS));
+    }
+    return config;
+}
+
+/**
+ * Take the model from _model_ready, waits if it is still loading.
+ * @return False if the model failed to load.
+ */
+bool stt::SpeechToText::attach_model()
+{
+    if (_ctx)
+        return true;
+    try {
+        _model = _model_ready.get();
+    } catch (const std::exception& e) {
+        std::cerr << "SpeechToText model failed to load: " << e.what() << "\n";
+        return false;
+    }
+    _ctx = _model.get();
+
+    // _sample_rate is used to set SFML sample rate, needs to match DS
+    // sample rate
+    assert(DS_GetModelSampleRate(_ctx) == _sample_rate);
+    return true;
+}
+
+/**
+ * @return True once the model is loaded (or failed to), run() won't wait for
+ * it. Never waits, safe to poll every frame from any thread.
+ */
+bool stt::SpeechToText::is_ready() const
+{
+    return _model_ready.wait_for(std::chrono::seconds(0))
+        == std::future_status::ready;
+}
+
 /**
  * Public run method to run SpeechToText.
+ * @param std::stop_token stop
+ * Checked between audio blocks, run() returns soon after a stop is requested
+ * (e.g., by TaskThread::stop()).
+ * @note Waits for the model if it is still loading (not stoppable), call it
+ * on its own thread (e.g., TaskThread).
+ * @remark Streams: audio is fed to DeepSpeech as it is captured, and words are
+ * parsed from intermediate decodes, no fixed recording window. Silence never
+ * reaches DeepSpeech, see VoiceActivity.
  */
-void stt::SpeechToText::run()
+void stt::SpeechToText::run(std::stop_token stop)
 {
     // run() was called, set _run to true and enter loop
     _run = true;
-    while (_run) {
-        // NOTE: if clear() sets _run to false, will break out of loop and exit
-        // run()
-        record();
+    if (!attach_model())
+        return;
+    _vad.reset();
+    // NOTE: sources default to 44100 (SFML), overwrite to 16000 for DS
+    if (!_source->start(static_cast<unsigned int>(_sample_rate))) {
+        std::cerr << "SpeechToText has no audio, not running.\n";
+        return;
+    }
+    while (_run && !stop.stop_requested() && !_source->is_finished()) {
+        // NOTE: if clear() sets _run to false, or stop is requested, will
+        // break out of loop and exit run() (within READ_TIMEOUT and a decode)
+        std::size_t count;
+        {
+            TraceSpan span("stt::record");
+            count = record();
+        }
+        feed(_samples.data(), count);
+    }
+    if (_source->is_finished())
+        finish_utterance();
+    _source->stop();
+    close_stream();
+
+    if (_source->get_dropped_count() > 0)
+        std::cerr << "SpeechToText dropped " << _source->get_dropped_count()
+            << " samples, decoding fell behind capture.\n";
+}
+
+/**
+ * The source ended mid-utterance (e.g., end of a file), feed silence until
+ * the utterance ends so its last words are decoded.
+ */
+void stt::SpeechToText::finish_utterance()
+{
+    std::fill(_samples.begin(), _samples.end(), 0);
+    for (std::size_t fed = 0; _vad.is_speaking()
+            && fed < static_cast<std::size_t>(_sample_rate);
+            fed += _samples.size())
+        feed(_samples.data(), _samples.size());
+}
+
+/**
+ * Run the pipeline (voice activity, decode, parse) on the next samples of a
+ * stream, run() feeds it the source. Keys go to the key queue as usual.
+ * @param const short* samples
+ * @param std::size_t count
+ * Mono 16-bit samples at the model's sample rate, in chunks of at most 4096
+ * (what run() reads) so nothing is allocated. An utterance ends after 300ms
+ * of silence, feed silence after the last one.
+ * @note Offline use (e.g., tools/stt-bench.cpp): call from one thread, and
+ * never together with run(). Waits for the model if it is still loading.
+ */
+void stt::SpeechToText::feed(const short* samples, std::size_t count)
+{
+    if (!attach_model())
+        return;
+    {
+        TraceSpan span("stt::listen");
+        listen(samples, count);
+    }
+    {
+        TraceSpan span("stt::decode");
         decode();
-        parse();
     }
+    TraceSpan span("stt::parse");
+    parse();
 }
 
 /**
- * Record audio buffer for DeepSpeech to decode.
- * @note Runs on a new thread, decode() and parse() DOES NOT.
- * @todo Threading should be addressed.
+ * Take the audio the source has for us into _samples (waits for it, at most
+ * READ_TIMEOUT).
+ * @return Number of samples read.
+ * @note The microphone captures on SFML's recording thread, decode() and
+ * parse() DO NOT. It keeps capturing into its ring while this thread decodes.
  */
-void stt::SpeechToText::record() {
-    // start the capture
-    // NOTE: start(sampleRate = 44100), overwrite default to 16000 for DS
-    std::cout << "Start recording\n";
-    _recorder.start(16000);
+std::size_t stt::SpeechToText::record() {
+    return _source->read(_samples.data(), _samples.size(), READ_TIMEOUT);
+}
 
-    // probably want some kind of set interval, not ideal, but workable
-    // ...a better solution is overlapping and catting buffers, or having an
-    // active buffer that is stream ... DS needs a buf though ... so not sure
-    // (?)
+/**
+ * Keep the part of samples that is speech.
+ */
+void stt::SpeechToText::listen(const short* samples, std::size_t count) {
+    _voiced.clear();
+    _vad.process(samples, count, _voiced);
 
-    // xxx need to decide on correct buf interval
-    sleep(2.5);
+    _buf.samples = _voiced.data();
+    _buf.count = static_cast<unsigned int>(_voiced.size());
 
-    // stop the capture
-    _recorder.stop();
-    std::cout << "End recording\n";
+    /** @brief AudioBuffer is fully instantiated, SAFE to proceed
+     * @note Each call of listen() will overwrite AudioBuffer. */
+}
 
-    // retrieve the buffer that contains the captured audio data
-    const sf::SoundBuffer& buf = _recorder.getBuffer();
+/**
+ * Feed the new speech to the stream and put newly decoded words in _decoded.
+ * A stream lasts one utterance: it is opened on the first voiced samples and
+ * finished when the utterance ends, in silence decode() costs nothing.
+ */
+void stt::SpeechToText::decode() {
+    _decoded.clear();
+
+    if (_buf.count > 0) {
+        if (!_sctx)
+            open_stream();
+        if (!_sctx)
+            return;
+
+        DS_FeedAudioContent(_sctx, _buf.samples, _buf.count);
+
+        // spot mode waits for the end of the utterance
+        if (_mode == Mode::Transcribe) {
+            /** @brief Convert local C char* stt to CXX std::string. stt is
+             * freed from memory, CXX std::string will handle memory
+             * management. */
+            char* stt = DS_IntermediateDecode(_sctx);
+            take_words(stt, false);
+            DS_FreeString(stt);
+        }
+    }
 
-    // need raw audio data
-    // is vector<sf::Int16>
-    // xxx convert sf::Int16 to short and std::vector to array - OK?
-    _buf.samples = static_cast<const short*>(buf.getSamples());
+    if (_vad.take_utterance_end() && _sctx) {
+        // DS_FinishStream*() frees the stream
+        if (_mode == Mode::Spot) {
+            Metadata* metadata = DS_FinishStreamWithMetadata(_sctx,
+                    SPOT_CANDIDATES);
+            _sctx = nullptr;
+            spot_words(*metadata);
+            DS_FreeMetadata(metadata);
+        } else {
+            char* stt = DS_FinishStream(_sctx);
+            _sctx = nullptr;
+            take_words(stt, true);
+            DS_FreeString(stt);
+        }
+    }
+}
 
-    // is std::size_t
-    _buf.count = static_cast<unsigned int>(buf.getSampleCount());
+/**
+ * Append the words of transcript that were not taken yet to _decoded.
+ * @remark The last word of an intermediate transcript may still be growing
+ * (e.g., "le" -> "left"), it is only taken once a decode leaves the
+ * transcript unchanged, or the transcript is final.
+ */
+void stt::SpeechToText::take_words(std::string_view transcript,
+        bool is_final)
+{
+    bool is_stable = is_final || transcript == _transcript;
+    _transcript = transcript;
+
+    std::string_view text = _transcript;
+    std::size_t count = 0;
+    std::string_view last;
+    for (std::string_view word = next_word(text); !word.empty();
+            word = next_word(text)) {
+        // hold the previous word back until we know it is not the last one
+        if (!last.empty() && count > _emitted_words) {
+            _decoded.append(last);
+            _decoded += ' ';
+        }
+        last = word;
+        ++count;
+    }
 
-    /** @brief AudioBuffer is fully instantiated, SAFE to proceed
-     * @note Each call of record() will overwrite AudioBuffer with a new
-     * sf::AudioBuffer. */
+    // last word is only taken when stable
+    if (is_stable && !last.empty() && count > _emitted_words) {
+        _decoded.append(last);
+        _decoded += ' ';
+    }
+    std::size_t ready = is_stable || count == 0 ? count : count - 1;
+    if (ready > _emitted_words)
+        _emitted_words = ready;
 }
 
-void stt::SpeechToText::decode() {
-    std::cout << "Start decoding\n";
-    char* stt = DS_SpeechToText(_ctx, _buf.samples, _buf.count);
-    std::cout << "End decoding\n";
+/**
+ * Append the vocabulary words of the best transcript that are confident
+ * enough to _decoded.
+ * @remark A word's confidence is the share of the N-best transcripts that
+ * hold it, each weighted by its (softmaxed) DeepSpeech confidence. A word
+ * the decoder is unsure of (e.g., "a" decoded from a noise) changes between
+ * candidates, and gets a low confidence.
+ */
+void stt::SpeechToText::spot_words(const Metadata& metadata)
+{
+    if (metadata.num_transcripts == 0)
+        return;
+
+    std::vector<std::string> texts;
+    std::vector<double> weights;
+    double best = metadata.transcripts[0].confidence;
+    for (unsigned int i = 0; i < metadata.num_transcripts; ++i)
+        best = std::max(best, metadata.transcripts[i].confidence);
+
+    double total = 0.0;
+    for (unsigned int i = 0; i < metadata.num_transcripts; ++i) {
+        const CandidateTranscript& candidate = metadata.transcripts[i];
+        std::string text;
+        for (unsigned int t = 0; t < candidate.num_tokens; ++t)
+            text += candidate.tokens[t].text;
+        texts.push_back(text);
+        weights.push_back(std::exp(candidate.confidence - best));
+        total += weights.back();
+    }
 
-    std::cout << stt << "\n";
+    std::string_view best_text = texts.front();
+    for (std::string_view word = next_word(best_text); !word.empty();
+            word = next_word(best_text)) {
+        if (_vocabulary.find(word) == Key::None)
+            continue;
 
-    /** @brief Convert local C char* stt to CXX member std::string decoded. stt
-     * is freed from memory, CXX std::string will handle memory management. */
-    _decoded = stt;
-    DS_FreeString(stt);
+        double score = 0.0;
+        for (std::size_t i = 0; i < texts.size(); ++i) {
+            std::string_view text = texts[i];
+            for (std::string_view other = next_word(text); !other.empty();
+                    other = next_word(text)) {
+                if (other == word) {
+                    score += weights[i];
+                    break;
+                }
+            }
+        }
+        score /= total;
+
+        if (score >= _spot_threshold) {
+            _decoded.append(word);
+            _decoded += ' ';
+        }
+    }
+}
+
+/**
+ * Create the DeepSpeech stream and reset what was decoded from the last one.
+ */
+void stt::SpeechToText::open_stream()
+{
+    int status = DS_CreateStream(_ctx, &_sctx);
+    if (status != 0) {
+        char* error = DS_ErrorCodeToErrorMessage(status);
+        fprintf(stderr, "Could not create stream: %s\n", error);
+        free(error);
+        _sctx = nullptr;
+        _run = false;
+    }
+    _transcript.clear();
+    _emitted_words = 0;
+}
+
+/**
+ * Free the stream, audio not decoded yet is discarded.
+ */
+void stt::SpeechToText::close_stream()
+{
+    if (_sctx)
+        DS_FreeStream(_sctx);
+    _sctx = nullptr;
 }
 
 /**
@@ -228,89 +511,51 @@ std::string stt::SpeechToText::get_decoded()
     return _decoded;
 }
 
+/**
+ * Parse _decoded for keys, each word is looked up in the vocabulary.
+ * @remark Words are views into _decoded, nothing is copied or allocated.
+ */
 void stt::SpeechToText::parse()
 {
-    /** @brief Parse CXX string for key inputs. */
-    std::istringstream in(_decoded);
-    std::string parse;
-    while (in >> parse) {
-        if (parse == "up")
-            _key_queue.push(Key::Up);
-        else if (parse == "down")
-            _key_queue.push(Key::Down);
-        else if (parse == "left")
-            _key_queue.push(Key::Left);
-        else if (parse == "right")
-            _key_queue.push(Key::Right);
-
-        /** @note Close words that should also be parsed as command:
-         *     "let" -> "left"
-         *     "but" -> "up"
-         *     "a" -> "up"
-         *     "bright" -> "right"
-         *     "he" -> "up"
-         *     "at" -> "up" LOOK INTO?
-         *     "last" -> left"
-         *     "downright" -> ???
-         *     "ran" -> right" MAYBE?
-         *     "man" -> ??
-         *     "lest" -> "left"
-         *     "last" -> "left"
-         *     "upright" -> ???
-         */
-
-        else if (parse == "but")
-            _key_queue.push(Key::Up);
-        else if (parse == "a")
-            _key_queue.push(Key::Up);
-        //else if (parse == "he") // NOTE: "he" is probably too common!
-        //    _key_queue.push(Key::Up);
-        else if (parse == "at")
-            _key_queue.push(Key::Up);
-        else if (parse == "let")
-            _key_queue.push(Key::Left);
-        else if (parse == "last")
-            _key_queue.push(Key::Left);
-        else if (parse == "left")
-            _key_queue.push(Key::Left);
-        else if (parse == "last")
-            _key_queue.push(Key::Left);
-        else if (parse == "laughed")
-            _key_queue.push(Key::Left);
-        else if (parse == "late")
-            _key_queue.push(Key::Left);
-
-        // AFTER CUSTOM SCORER:
-        else if (parse == "le")
-            _key_queue.push(Key::Left);
-
-        else if (parse == "play")
-            _key_queue.push(Key::Play);
-        else if (parse == "exit")
-            _key_queue.push(Key::Exit);
-
-        else
-            continue;
+    std::string_view text = _decoded;
+    for (std::string_view word = next_word(text); !word.empty();
+            word = next_word(text)) {
+        Key key = _vocabulary.find(word);
+        if (key != Key::None)
+            _key_queue.push(key);
     }
 }
 
+/**
+ * Stop run() and discard queued keys.
+ * @note Call from the thread that polls keys.
+ */
 void stt::SpeechToText::clear()
 {
-    std::queue<Key> empty;
-    std::swap(_key_queue, empty);
+    _key_queue.clear();
     _run = false;
 }
 
-stt::Key stt::SpeechToText::get_key()
+/**
+ * @param Key& key
+ * Output, the oldest key that is not stale.
+ * @return False if there is no (fresh) key.
+ * @note Consumer side of the key queue, call from one thread only (the game
+ * thread).
+ */
+bool stt::SpeechToText::poll_key(Key& key)
+{
+    return _key_queue.pop_fresh(key, _key_deadline);
+}
+
+void stt::SpeechToText::set_key_deadline(std::chrono::milliseconds deadline)
 {
-    stt::Key key = _key_queue.front();
-    _key_queue.pop();
-    return key;
+    _key_deadline = deadline;
 }
 
-bool stt::SpeechToText::key_queue_is_empty() const
+void stt::SpeechToText::set_spot_threshold(double threshold)
 {
-    return _key_queue.empty();
+    _spot_threshold = threshold;
 }
 
 /**
@@ -318,5 +563,6 @@ bool stt::SpeechToText::key_queue_is_empty() const
 */
 stt::SpeechToText::~SpeechToText()
 {
-    DS_FreeModel(_ctx);
+    // the model is freed by the cache with its last user
+    close_stream();
 }
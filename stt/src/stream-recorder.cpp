@@ -0,0 +1,67 @@
+#include "stream-recorder.h"
+
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Sleep.hpp>
+
+namespace {
+    // 2s at 16kHz, rounded up to a power of 2 by SpscRing
+    constexpr std::size_t RING_CAPACITY = 32000;
+    // read() polls the ring this often while it is empty
+    const sf::Time POLL_INTERVAL = sf::milliseconds(5);
+}
+
+stt::StreamRecorder::StreamRecorder() :
+    _ring(RING_CAPACITY),
+    _dropped(0)
+{
+    // SFML default is 100ms, smaller chunks reach the decoder sooner
+    setProcessingInterval(sf::milliseconds(50));
+}
+
+/**
+ * @note Derived sf::SoundRecorder must stop capture itself, before its members
+ * are destroyed.
+ */
+stt::StreamRecorder::~StreamRecorder()
+{
+    stop();
+}
+
+/**
+ * Move captured samples out of the ring.
+ * @param short* samples
+ * Output, room for count samples.
+ * @param sf::Time timeout
+ * Wait at most this long for samples.
+ * @return Number of samples read, 0 if nothing was captured before the
+ * timeout.
+ */
+std::size_t stt::StreamRecorder::read(short* samples, std::size_t count,
+        sf::Time timeout)
+{
+    sf::Clock clock;
+    for (;;) {
+        std::size_t read = _ring.pop(samples, count);
+        if (read > 0 || clock.getElapsedTime() >= timeout)
+            return read;
+        sf::sleep(POLL_INTERVAL);
+    }
+}
+
+/**
+ * @return Samples lost because the decoder did not keep up.
+ */
+std::size_t stt::StreamRecorder::get_dropped_count() const
+{
+    return _dropped.load(std::memory_order_relaxed);
+}
+
+bool stt::StreamRecorder::onProcessSamples(const sf::Int16* samples,
+        std::size_t count)
+{
+    std::size_t pushed = _ring.push(samples, count);
+    if (pushed < count)
+        _dropped.fetch_add(count - pushed, std::memory_order_relaxed);
+    // keep capturing
+    return true;
+}
@@ -0,0 +1,35 @@
+#include "trace-hook.h"
+
+#include <atomic>
+
+namespace {
+    std::atomic<stt::TraceHook> trace_hook(nullptr);
+}
+
+/**
+ * @param TraceHook hook
+ * nullptr to stop tracing. Must be safe to call from any thread.
+ */
+void stt::set_trace_hook(TraceHook hook)
+{
+    trace_hook.store(hook, std::memory_order_release);
+}
+
+/**
+ * @param const char* name
+ * Static string, only the pointer is passed on.
+ */
+stt::TraceSpan::TraceSpan(const char* name) :
+    _name(name),
+    _hook(trace_hook.load(std::memory_order_acquire)),
+    _begin()
+{
+    if (_hook)
+        _begin = std::chrono::steady_clock::now();
+}
+
+stt::TraceSpan::~TraceSpan()
+{
+    if (_hook)
+        _hook(_name, _begin, std::chrono::steady_clock::now());
+}
@@ -0,0 +1,154 @@
+#include "voice-activity.h"
+
+#include <algorithm>
+
+namespace {
+    // 20ms frames
+    constexpr int FRAMES_PER_SECOND = 50;
+    // voiced frames in a row to start an utterance (ignores clicks)
+    constexpr int ONSET_FRAMES = 2;
+    // audio kept before the onset (200ms)
+    constexpr int PREROLL_FRAMES = 10;
+    // silent frames to end an utterance (300ms)
+    constexpr int HANGOVER_FRAMES = 15;
+    // longest utterance (10s), e.g. steady noise that got above the floor
+    constexpr int MAX_UTTERANCE_FRAMES = 10 * FRAMES_PER_SECOND;
+    // voiced: energy over the noise floor times this (~6dB)
+    constexpr double ENERGY_RATIO = 4.0;
+    // never voiced below this mean square (amplitude ~100 of 32767)
+    constexpr double MIN_ENERGY = 100.0 * 100.0;
+    // zero crossings per sample of unvoiced consonants (noise-like)
+    constexpr double UNVOICED_ZERO_CROSSINGS = 0.25;
+    // noise floor smoothing, per silent frame
+    constexpr double NOISE_ADAPT_RATE = 0.05;
+}
+
+/**
+ * @param int sample_rate
+ * Sample rate of the processed audio (mono), 16000 for DeepSpeech.
+ */
+stt::VoiceActivity::VoiceActivity(int sample_rate) :
+    _frame_size(static_cast<std::size_t>(sample_rate / FRAMES_PER_SECOND)),
+    _frame(),
+    _preroll(),
+    _noise_energy(0.0),
+    _is_speaking(false),
+    _utterance_ended(false),
+    _voiced_frames(0),
+    _silent_frames(0),
+    _utterance_frames(0)
+{
+    _frame.reserve(_frame_size);
+    _preroll.reserve(_frame_size * (PREROLL_FRAMES + 1));
+}
+
+/**
+ * Run captured audio through the detector.
+ * @param std::vector<short>& voiced
+ * Output, samples of the current utterance are appended (nothing in silence).
+ * @note Samples that do not fill a frame are kept for the next call.
+ */
+void stt::VoiceActivity::process(const short* samples, std::size_t count,
+        std::vector<short>& voiced)
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        _frame.push_back(samples[i]);
+        if (_frame.size() == _frame_size) {
+            process_frame(voiced);
+            _frame.clear();
+        }
+    }
+}
+
+/**
+ * @return True while inside an utterance.
+ */
+bool stt::VoiceActivity::is_speaking() const
+{
+    return _is_speaking;
+}
+
+/**
+ * @return True once after each utterance ends, time to finish the decode.
+ */
+bool stt::VoiceActivity::take_utterance_end()
+{
+    bool ended = _utterance_ended;
+    _utterance_ended = false;
+    return ended;
+}
+
+/**
+ * Forget the current utterance and the noise floor (e.g., new recording).
+ */
+void stt::VoiceActivity::reset()
+{
+    _frame.clear();
+    _preroll.clear();
+    _noise_energy = 0.0;
+    _is_speaking = false;
+    _utterance_ended = false;
+    _voiced_frames = 0;
+    _silent_frames = 0;
+    _utterance_frames = 0;
+}
+
+bool stt::VoiceActivity::is_voiced(double energy, double zero_crossings) const
+{
+    double threshold = std::max(_noise_energy * ENERGY_RATIO, MIN_ENERGY);
+    return energy > threshold
+        || (energy > threshold * 0.5
+                && zero_crossings > UNVOICED_ZERO_CROSSINGS);
+}
+
+void stt::VoiceActivity::process_frame(std::vector<short>& voiced)
+{
+    double energy = 0.0;
+    int crossings = 0;
+    for (std::size_t i = 0; i < _frame.size(); ++i) {
+        energy += double(_frame[i]) * _frame[i];
+        if (i > 0 && (_frame[i - 1] < 0) != (_frame[i] < 0))
+            ++crossings;
+    }
+    energy /= static_cast<double>(_frame.size());
+    double zero_crossings = crossings / static_cast<double>(_frame.size());
+    bool is_frame_voiced = is_voiced(energy, zero_crossings);
+
+    if (!_is_speaking) {
+        // track the noise floor in silence only
+        if (_noise_energy == 0.0)
+            _noise_energy = energy;
+        else if (!is_frame_voiced)
+            _noise_energy += (energy - _noise_energy) * NOISE_ADAPT_RATE;
+
+        _preroll.insert(_preroll.end(), _frame.begin(), _frame.end());
+        if (_preroll.size() > _frame_size * PREROLL_FRAMES)
+            _preroll.erase(_preroll.begin(), _preroll.begin() + _frame_size);
+
+        _voiced_frames = is_frame_voiced ? _voiced_frames + 1 : 0;
+        if (_voiced_frames < ONSET_FRAMES)
+            return;
+
+        // onset, send the pre-roll (it holds this frame)
+        _is_speaking = true;
+        _silent_frames = 0;
+        _utterance_frames = _voiced_frames;
+        voiced.insert(voiced.end(), _preroll.begin(), _preroll.end());
+        _preroll.clear();
+        return;
+    }
+
+    voiced.insert(voiced.end(), _frame.begin(), _frame.end());
+    ++_utterance_frames;
+    _silent_frames = is_frame_voiced ? 0 : _silent_frames + 1;
+    if (_silent_frames < HANGOVER_FRAMES
+            && _utterance_frames < MAX_UTTERANCE_FRAMES)
+        return;
+
+    // a cut utterance means the floor is too low, start over from this level
+    if (_utterance_frames >= MAX_UTTERANCE_FRAMES)
+        _noise_energy = energy;
+    _is_speaking = false;
+    _utterance_ended = true;
+    _voiced_frames = 0;
+}
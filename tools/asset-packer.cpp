@@ -0,0 +1,169 @@
+/** @file asset-packer.cpp
+ * Builds an asset pack (see asset-pack.h) from the files of a resource
+ * directory listed in a manifest (one path relative to the directory per
+ * line, # for comments). Images are decoded here once, the game uploads their
+ * RGBA pixels as is.
+ * @remark Only list what the game loads, decoded images are large (raw RGBA).
+ * @code
+ * asset-packer <res dir> <manifest> <output pack>
+ * @endcode
+ */
+
+#include "asset-pack.h"
+
+#include <SFML/Graphics/Image.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+    struct Asset {
+        Pack::Entry entry;
+        std::vector<char> data;
+    };
+
+    bool read_file(const fs::path& path, std::vector<char>& data)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+            return false;
+        data.assign(std::istreambuf_iterator<char>(file),
+                std::istreambuf_iterator<char>());
+        return true;
+    }
+
+    /// Pack type of a file, from its extension, false to skip the file.
+    bool get_type(const fs::path& path, Pack::Type& type)
+    {
+        std::string extension = path.extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(),
+                [] (unsigned char c) { return std::tolower(c); });
+        if (extension == ".png" || extension == ".jpg" || extension == ".bmp")
+            type = Pack::Type::Texture;
+        else if (extension == ".ttf" || extension == ".otf")
+            type = Pack::Type::Font;
+        else
+            return false;
+        return true;
+    }
+
+    bool load_asset(const fs::path& path, Pack::Type type, Asset& asset)
+    {
+        asset.entry.type = type;
+        if (type != Pack::Type::Texture)
+            return read_file(path, asset.data);
+
+        sf::Image image;
+        if (!image.loadFromFile(path.string()))
+            return false;
+        sf::Vector2u size = image.getSize();
+        const char* pixels = reinterpret_cast<const char*>(image.getPixelsPtr());
+        asset.entry.width = size.x;
+        asset.entry.height = size.y;
+        asset.data.assign(pixels, pixels + std::size_t(size.x) * size.y * 4);
+        return true;
+    }
+
+    std::uint64_t align(std::uint64_t offset)
+    {
+        return (offset + Pack::ALIGNMENT - 1) / Pack::ALIGNMENT
+            * Pack::ALIGNMENT;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc != 4) {
+        std::cerr << "usage: " << argv[0]
+            << " <res dir> <manifest> <output pack>\n";
+        return 1;
+    }
+    fs::path root = argv[1];
+    fs::path output = argv[3];
+
+    std::ifstream manifest(argv[2]);
+    if (!manifest) {
+        std::cerr << "Failed to open " << argv[2] << "\n";
+        return 1;
+    }
+
+    // collect assets, named by their path relative to root
+    std::vector<Asset> assets;
+    std::string name;
+    while (std::getline(manifest, name)) {
+        if (name.empty() || name[0] == '#')
+            continue;
+
+        Pack::Type type = Pack::Type::Blob;
+        if (!get_type(name, type)) {
+            std::cerr << "Unknown asset type " << name << "\n";
+            return 1;
+        }
+        if (name.size() >= Pack::NAME_SIZE) {
+            std::cerr << "Name is too long " << name << "\n";
+            return 1;
+        }
+
+        Asset asset{};
+        std::strncpy(asset.entry.name, name.c_str(), Pack::NAME_SIZE - 1);
+        if (!load_asset(root / name, type, asset)) {
+            std::cerr << "Failed to load " << name << "\n";
+            return 1;
+        }
+        assets.push_back(std::move(asset));
+    }
+
+    // entries are binary searched by name at runtime
+    std::sort(assets.begin(), assets.end(),
+            [] (const Asset& lhs, const Asset& rhs) {
+        return std::strcmp(lhs.entry.name, rhs.entry.name) < 0;
+    });
+
+    Pack::Header header{};
+    std::memcpy(header.magic, Pack::MAGIC, sizeof(Pack::MAGIC));
+    header.version = Pack::VERSION;
+    header.entry_count = static_cast<std::uint32_t>(assets.size());
+
+    std::uint64_t offset = sizeof(Pack::Header)
+        + assets.size() * sizeof(Pack::Entry);
+    for (Asset& asset : assets) {
+        offset = align(offset);
+        asset.entry.offset = offset;
+        asset.entry.size = asset.data.size();
+        offset += asset.entry.size;
+    }
+
+    std::ofstream file(output, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        std::cerr << "Failed to open " << output << "\n";
+        return 1;
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (const Asset& asset : assets)
+        file.write(reinterpret_cast<const char*>(&asset.entry),
+                sizeof(asset.entry));
+    for (const Asset& asset : assets) {
+        // pad up to the aligned offset
+        std::uint64_t padding = asset.entry.offset
+            - static_cast<std::uint64_t>(file.tellp());
+        file.write(std::string(padding, '\0').data(), padding);
+        file.write(asset.data.data(), asset.data.size());
+    }
+    if (!file) {
+        std::cerr << "Failed to write " << output << "\n";
+        return 1;
+    }
+
+    std::cout << "Packed " << assets.size() << " assets into " << output
+        << " (" << offset << " bytes)\n";
+    return 0;
+}
@@ -0,0 +1,265 @@
+/** @file stt-bench.cpp
+ * Replays a directory of recorded commands through SpeechToText (voice
+ * activity, decode, parse, as in game, without the microphone) and reports
+ * decode latency, real-time factor, and what each command was taken for.
+ * @remark WAV files must be 16 kHz mono 16-bit (the model's format), .raw
+ * and .pcm files are taken to be 16 kHz mono 16-bit samples. The
+ * expected command of a file is its name up to the first '_' or '-' (e.g.,
+ * left_03.wav), "none" for files that should give no command. A labels.txt
+ * in the directory (file name then label per line, # for comments) takes
+ * precedence.
+ * @code
+ * stt-bench [--transcribe] [--beam <width>] [--scorer <path>]
+ *     [--no-hot-words] <wav dir>
+ * @endcode
+ */
+
+#include "speech-to-text.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+    const unsigned int SAMPLE_RATE = 16000;
+    /// Samples per feed(), what SpeechToText::run() reads at most.
+    const std::size_t CHUNK_SAMPLES = 4096;
+    /// Silence after each file, longer than the voice activity hangover so
+    /// the utterance ends before the next file.
+    const std::size_t TAIL_SAMPLES = SAMPLE_RATE;
+
+    /// Matrix rows and columns, None first.
+    const stt::Key KEYS[] = {
+        stt::Key::None, stt::Key::Up, stt::Key::Down, stt::Key::Left,
+        stt::Key::Right, stt::Key::Play, stt::Key::Exit,
+    };
+    const char* const KEY_NAMES[] = {
+        "none", "up", "down", "left", "right", "play", "exit",
+    };
+    const std::size_t KEY_COUNT = sizeof(KEYS) / sizeof(KEYS[0]);
+
+    /// Row/column of a key, false if it isn't benchmarked (e.g., Key::A).
+    bool find_index(stt::Key key, std::size_t& index)
+    {
+        for (index = 0; index < KEY_COUNT; ++index)
+            if (KEYS[index] == key)
+                return true;
+        return false;
+    }
+
+    bool find_label(const std::string& name, std::size_t& index)
+    {
+        for (index = 0; index < KEY_COUNT; ++index)
+            if (name == KEY_NAMES[index])
+                return true;
+        return false;
+    }
+
+    /// labels.txt of dir, file name to label, empty if there is none.
+    std::map<std::string, std::string> read_labels(const fs::path& dir)
+    {
+        std::map<std::string, std::string> labels;
+        std::ifstream file(dir / "labels.txt");
+        std::string line;
+        while (std::getline(file, line)) {
+            std::istringstream in(line);
+            std::string name, label;
+            if (in >> name >> label && name[0] != '#')
+                labels[name] = label;
+        }
+        return labels;
+    }
+
+    /// Nearest-rank percentile of sorted values, in milliseconds.
+    double percentile(const std::vector<double>& sorted, double p)
+    {
+        if (sorted.empty())
+            return 0.;
+        std::size_t rank = static_cast<std::size_t>(p / 100.
+                * static_cast<double>(sorted.size()) + 0.5);
+        return sorted[std::clamp<std::size_t>(rank, 1, sorted.size()) - 1];
+    }
+
+    struct Stats {
+        /// Wall time of the feed() calls that gave a key.
+        std::vector<double> latencies_ms;
+        double decode_seconds = 0.;
+        double audio_seconds = 0.;
+        std::size_t confusion[KEY_COUNT][KEY_COUNT] = {};
+        std::size_t extra_keys = 0;
+    };
+
+    /**
+     * Feed one file (then silence) to stt, at full speed.
+     * @return False if the file can't be used.
+     */
+    bool bench_file(stt::SpeechToText& stt, const fs::path& path,
+            std::size_t expected, Stats& stats)
+    {
+        stt::FileSource file(path.string(), stt::AudioSource::Pace::MaxSpeed);
+        if (!file.start(SAMPLE_RATE)) {
+            std::cerr << path.filename().string() << ": skipped\n";
+            return false;
+        }
+
+        std::vector<short> chunk(CHUNK_SAMPLES);
+        std::size_t tail = TAIL_SAMPLES;
+        std::size_t predicted = 0;
+        bool has_key = false;
+        for (;;) {
+            std::size_t count = file.read(chunk.data(), chunk.size(),
+                    sf::Time::Zero);
+            if (count == 0) {
+                if (tail == 0)
+                    break;
+                count = std::min(tail, chunk.size());
+                std::fill(chunk.begin(), chunk.begin() + count, 0);
+                tail -= count;
+            }
+
+            Clock::time_point start = Clock::now();
+            stt.feed(chunk.data(), count);
+            std::chrono::duration<double> elapsed = Clock::now() - start;
+            stats.decode_seconds += elapsed.count();
+            stats.audio_seconds += static_cast<double>(count) / SAMPLE_RATE;
+
+            stt::Key key;
+            while (stt.poll_key(key)) {
+                std::size_t index;
+                if (!find_index(key, index))
+                    continue;
+                stats.latencies_ms.push_back(elapsed.count() * 1000.);
+                if (has_key) {
+                    ++stats.extra_keys;
+                    continue;
+                }
+                predicted = index;
+                has_key = true;
+            }
+        }
+        ++stats.confusion[expected][predicted];
+        return true;
+    }
+
+    void report(const Stats& stats)
+    {
+        std::vector<double> sorted = stats.latencies_ms;
+        std::sort(sorted.begin(), sorted.end());
+
+        std::cout << std::fixed << std::setprecision(1)
+            << "\nutterances: " << sorted.size()
+            << "\nlatency ms: p50 " << percentile(sorted, 50.)
+            << ", p90 " << percentile(sorted, 90.)
+            << ", p99 " << percentile(sorted, 99.)
+            << ", max " << (sorted.empty() ? 0. : sorted.back())
+            << std::setprecision(3)
+            << "\nreal-time factor: " << (stats.audio_seconds > 0.
+                    ? stats.decode_seconds / stats.audio_seconds : 0.)
+            << " (" << stats.decode_seconds << "s for "
+            << stats.audio_seconds << "s of audio)"
+            << "\nextra keys: " << stats.extra_keys << "\n";
+
+        // rows are expected, columns taken
+        std::size_t correct = 0, total = 0;
+        std::cout << "\nexpected \\ taken";
+        for (const char* name : KEY_NAMES)
+            std::cout << std::setw(7) << name;
+        std::cout << "\n";
+        for (std::size_t row = 0; row < KEY_COUNT; ++row) {
+            std::cout << std::setw(16) << KEY_NAMES[row];
+            for (std::size_t column = 0; column < KEY_COUNT; ++column) {
+                std::cout << std::setw(7) << stats.confusion[row][column];
+                total += stats.confusion[row][column];
+            }
+            correct += stats.confusion[row][row];
+            std::cout << "\n";
+        }
+        std::cout << std::setprecision(1) << "accuracy: "
+            << (total > 0 ? 100. * static_cast<double>(correct)
+                    / static_cast<double>(total) : 0.)
+            << "% (" << correct << "/" << total << ")\n";
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    stt::SpeechToText::Mode mode = stt::SpeechToText::Mode::Spot;
+    bool has_beam = false, no_hot_words = false;
+    unsigned int beam_width = 0;
+    std::string scorer;
+    fs::path dir;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--transcribe") {
+            mode = stt::SpeechToText::Mode::Transcribe;
+        } else if (arg == "--beam" && i + 1 < argc) {
+            beam_width = static_cast<unsigned int>(std::atoi(argv[++i]));
+            has_beam = true;
+        } else if (arg == "--scorer" && i + 1 < argc) {
+            scorer = argv[++i];
+        } else if (arg == "--no-hot-words") {
+            no_hot_words = true;
+        } else if (dir.empty() && arg[0] != '-') {
+            dir = arg;
+        } else {
+            dir.clear();
+            break;
+        }
+    }
+    if (dir.empty()) {
+        std::cerr << "usage: " << argv[0] << " [--transcribe] [--beam <width>]"
+            " [--scorer <path>] [--no-hot-words] <wav dir>\n";
+        return 1;
+    }
+
+    stt::ModelConfig config = stt::SpeechToText::default_model_config(mode);
+    if (has_beam)
+        config.beam_width = beam_width;
+    if (!scorer.empty())
+        config.scorer_path = scorer;
+    if (no_hot_words)
+        config.hot_words.clear();
+
+    std::vector<fs::path> files;
+    for (const fs::directory_entry& entry : fs::directory_iterator(dir))
+        if (entry.path().extension() == ".wav"
+                || entry.path().extension() == ".raw"
+                || entry.path().extension() == ".pcm")
+            files.push_back(entry.path());
+    std::sort(files.begin(), files.end());
+    std::map<std::string, std::string> labels = read_labels(dir);
+
+    stt::SpeechToText stt(mode, config);
+    // keys are polled right after each chunk, none go stale
+    stt.set_key_deadline(std::chrono::hours(1));
+    // don't time the model load
+    while (!stt.is_ready())
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    Stats stats;
+    for (const fs::path& path : files) {
+        std::string name = path.filename().string();
+        std::string label = labels.count(name) ? labels[name]
+            : name.substr(0, name.find_first_of("_-."));
+        std::size_t expected;
+        if (!find_label(label, expected)) {
+            std::cerr << name << ": unknown label " << label << ", skipped\n";
+            continue;
+        }
+        bench_file(stt, path, expected, stats);
+    }
+    report(stats);
+    return 0;
+}
@@ -0,0 +1,216 @@
+/** @file world-bench.cpp
+ * Steps the World without a window (no drawing, no Player input) over
+ * generated scenes of increasing entity counts, with scripted movement, and
+ * reports ticks per second and what each phase of World::update() cost,
+ * both over every tick of the scene.
+ * @remark Runs from the build dir like the game (textures/, fonts/, or
+ * assets.pack). Textures still need an OpenGL context, SFML makes a hidden
+ * one - on a server without a display, run it under a virtual one (e.g.,
+ * xvfb-run world-bench).
+ * @remark With --min-tps, exits with 1 if a scene steps slower, to gate
+ * simulation performance regressions.
+ * @code
+ * world-bench [--ticks <n>] [--min-tps <ticks/s>] [<entity count>...]
+ * @endcode
+ */
+
+#include "world.h"
+#include "creature.h"
+#include "command.h"
+#include "category.h"
+#include "profiler.h"
+#include "asset-pack.h"
+#include "conf.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+    /// Size of the World (see World::World()), entities spawn inside it.
+    const sf::FloatRect WORLD_BOUNDS(0.f, 0.f, 7000.f, 4500.f);
+    /// Ticks the scripted input holds a direction.
+    const std::size_t TICKS_PER_DIRECTION = 30;
+    /// Same scenes every run.
+    const unsigned int SEED = 1;
+
+    /// Only the phases of World::update(), Update is the whole tick.
+    const Profiler::Phase PHASES[] = {
+        Profiler::Update, Profiler::Commands, Profiler::Collisions,
+        Profiler::Spawns, Profiler::SceneUpdate, Profiler::AdaptView,
+    };
+    const std::size_t PHASE_COUNT = sizeof(PHASES) / sizeof(PHASES[0]);
+
+    /// Held direction, a round of right, down, left, up.
+    sf::Vector2f get_direction(std::size_t tick)
+    {
+        static const sf::Vector2f DIRECTIONS[] = {
+            {+5.f, 0.f}, {0.f, +5.f}, {-5.f, 0.f}, {0.f, -5.f},
+        };
+        return DIRECTIONS[tick / TICKS_PER_DIRECTION % 4];
+    }
+
+    /**
+     * The movement of Player's arrow keys, every Category::Player Creature
+     * follows it. Sets the velocity: World only resets its own player's
+     * velocity every tick, accelerating would speed the other walkers up
+     * without bound. A walker that would step out of WORLD_BOUNDS bounces
+     * back instead (World only keeps its own player inside).
+     */
+    Command make_move_command(sf::Vector2f direction)
+    {
+        Command move;
+        move.category = Category::Player;
+        move.action = derived_action<Creature>(
+                [direction] (Creature& creature, sf::Time delta_time) {
+                    sf::Vector2f velocity = direction
+                        * creature.get_max_speed();
+                    sf::Vector2f next = creature.getPosition()
+                        + velocity * delta_time.asSeconds();
+                    // only flip outward moves, one pushed out walks back
+                    if ((next.x < WORLD_BOUNDS.left && velocity.x < 0.f)
+                            || (next.x > WORLD_BOUNDS.left + WORLD_BOUNDS.width
+                                && velocity.x > 0.f))
+                        velocity.x = -velocity.x;
+                    if ((next.y < WORLD_BOUNDS.top && velocity.y < 0.f)
+                            || (next.y > WORLD_BOUNDS.top + WORLD_BOUNDS.height
+                                && velocity.y > 0.f))
+                        velocity.y = -velocity.y;
+                    creature.set_velocity(velocity);
+                });
+        return move;
+    }
+
+    /**
+     * Scatter count walkers (Player Creatures, the only ones that move) over
+     * the world, on top of the map assets.
+     */
+    void generate_scene(World& world, std::size_t count)
+    {
+        std::mt19937 rng(SEED);
+        std::uniform_real_distribution<float> x(WORLD_BOUNDS.left,
+                WORLD_BOUNDS.left + WORLD_BOUNDS.width);
+        std::uniform_real_distribution<float> y(WORLD_BOUNDS.top,
+                WORLD_BOUNDS.top + WORLD_BOUNDS.height);
+        for (std::size_t i = 0; i < count; ++i)
+            world.add_creature(Creature::Player, sf::Vector2f(x(rng), y(rng)));
+    }
+
+    /**
+     * Step a scene of count walkers for ticks ticks.
+     * @return Ticks per second.
+     */
+    double bench_scene(TextureHolder& textures, FontHolder& fonts,
+            std::size_t count, std::size_t ticks)
+    {
+        World world(nullptr, textures, fonts);
+        generate_scene(world, count);
+        // spawn the scene outside of the timing
+        world.update(conf::TIME_PER_FRAME);
+        Profiler::reset();
+
+        // every tick's phase timings, Profiler only keeps its last WINDOW
+        std::vector<std::vector<float>> timings(PHASE_COUNT);
+        for (std::vector<float>& phase_timings : timings)
+            phase_timings.reserve(ticks);
+        std::chrono::duration<double> elapsed(0.);
+        for (std::size_t tick = 0; tick < ticks; ++tick) {
+            Clock::time_point start = Clock::now();
+            {
+                ProfileProbe probe(Profiler::Update);
+                world.get_command_queue().push(
+                        make_move_command(get_direction(tick)));
+                world.update(conf::TIME_PER_FRAME);
+            }
+            elapsed += Clock::now() - start;
+            for (std::size_t i = 0; i < PHASE_COUNT; ++i)
+                timings[i].push_back(Profiler::get_last(PHASES[i]));
+        }
+        double ticks_per_second = elapsed.count() > 0.
+            ? static_cast<double>(ticks) / elapsed.count() : 0.;
+
+        std::cout << std::fixed << std::setprecision(1)
+            << "\nentities: " << count << ", ticks: " << ticks
+            << ", " << ticks_per_second << " ticks/s\n";
+        std::cout << std::setprecision(3) << std::setw(14) << "phase (ms)"
+            << std::setw(10) << "mean" << std::setw(10) << "p95"
+            << std::setw(10) << "max" << "\n";
+        for (std::size_t i = 0; i < PHASE_COUNT; ++i) {
+            std::vector<float>& sorted = timings[i];
+            std::sort(sorted.begin(), sorted.end());
+            double total = 0.;
+            for (float timing : sorted)
+                total += timing;
+            std::cout << std::setw(14) << Profiler::get_name(PHASES[i])
+                << std::setw(10) << total / static_cast<double>(ticks)
+                << std::setw(10) << sorted[(ticks - 1) * 95 / 100]
+                << std::setw(10) << sorted.back() << "\n";
+        }
+        return ticks_per_second;
+    }
+
+    void print_usage(const char* name)
+    {
+        std::cerr << "usage: " << name << " [--ticks <n>] [--min-tps "
+            "<ticks/s>] [<entity count>...]\n";
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    std::size_t ticks = 3600;
+    double min_ticks_per_second = 0.;
+    std::vector<std::size_t> counts;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--ticks" && i + 1 < argc) {
+            ticks = std::strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--min-tps" && i + 1 < argc) {
+            min_ticks_per_second = std::strtod(argv[++i], nullptr);
+        } else if (!arg.empty() && arg[0] != '-') {
+            counts.push_back(std::strtoul(arg.c_str(), nullptr, 10));
+        } else {
+            print_usage(argv[0]);
+            return 2;
+        }
+    }
+    if (counts.empty())
+        counts = {0, 100, 1000, 4000};
+    if (ticks == 0) {
+        print_usage(argv[0]);
+        return 2;
+    }
+
+    // same assets as the game, packed if there is a pack
+    AssetPack pack;
+    TextureHolder textures;
+    FontHolder fonts;
+    if (pack.open(conf::ASSET_PACK)) {
+        textures.set_asset_pack(&pack);
+        fonts.set_asset_pack(&pack);
+    }
+    try {
+        fonts.load(Fonts::Main, "fonts/Kaph-Regular.ttf");
+    } catch (std::exception& e) {
+        std::cerr << "exception: " << e.what() << std::endl;
+        return 2;
+    }
+
+    bool is_slow = false;
+    for (std::size_t count : counts) {
+        double ticks_per_second = bench_scene(textures, fonts, count, ticks);
+        if (ticks_per_second < min_ticks_per_second) {
+            std::cout << "below " << min_ticks_per_second << " ticks/s\n";
+            is_slow = true;
+        }
+    }
+    return is_slow ? 1 : 0;
+}